@@ -0,0 +1,4 @@
+#include "BucketChainHashTable.hpp"
+
+template struct BucketChainHashTable<FibonacciHash>;
+template struct BucketChainHashTable<ModuloHash>;
@@ -0,0 +1,316 @@
+#pragma once
+#include <cstdint>
+#include "HashTable.hpp"
+
+//          --Closed addressing, unrolled chains--
+// Separate chaining where each bucket is one cache line holding BLOCK_SLOTS keys, a full block links to overflow blocks
+// from a slab pool. A lookup compares the keys of a block without following a pointer per item, misses never leave the
+// blocks. Items live in a dense array in insertion order, blocks store their positions, so a resize only rebuilds the
+// blocks and values are never moved. Grow when load factor > 4 by default: a block holds 6 keys, so at up to 4 items per
+// bucket most buckets still fit in their first block while the block array stays a quarter of the item count.
+template <typename Hash = ModuloHash, typename Key = unsigned int, typename Value = std::string>
+struct BucketChainHashTable {
+    using KeyType = Key;
+    using ValueType = Value;
+    using ValueViewType = ValueView<Value>; // search() result, a string_view into the table for string values
+    static constexpr unsigned int BLOCK_SLOTS = 6; // With 32-bit keys: 6 keys, 6 positions, the used count and the next pointer fill 64 bytes
+    struct Entry {
+        Key key; // UserID
+        Value value; // Password
+    };
+    struct alignas(64) Block {
+        Key keys[BLOCK_SLOTS]; // Scanned first, kept apart from the positions
+        unsigned int items[BLOCK_SLOTS]; // items[i]: position of keys[i]'s Entry in entries
+        unsigned int used = 0; // Slots filled front to back, every block of a chain but the last is full
+        Block* next = nullptr; // Overflow block
+    };
+    // Slab allocator for overflow blocks, released blocks go on a free list and are reused before a new slab is taken
+    struct BlockPool {
+        static constexpr unsigned int SLAB_SIZE = 1024; // Blocks per slab
+        std::vector<std::unique_ptr<Block[]>> slabs; // Owns every overflow block
+        unsigned int slabUsed = SLAB_SIZE; // Blocks handed out from the last slab
+        Block* freeList = nullptr; // Released blocks, linked through next
+
+        Block* allocate();
+        void release(Block* block);
+    };
+
+    Hash hash; // Hash policy, picks the bucket
+    unsigned int size, sizePower, count = 0, overflowCount = 0; // overflowCount: overflow blocks in use
+    std::vector<Block> table; // First block of every bucket, inline in the array
+    std::vector<Entry> entries; // Every item, removes move the last one into the hole
+    ProbeStats stats; // Probe length histogram in blocks, empty unless built with HASH_TABLE_STATS
+    BlockPool pool;
+    LoadFactor load; // Grow and shrink limits, 4 and 0.5 unless set
+
+    BucketChainHashTable(unsigned int size, Hash hash = Hash());
+
+    void resetStats(); // Clear the probe length histogram
+    unsigned int hashFunction(Key key) const { return hash(key, sizePower); } // Hashing method from the Hash policy
+    double expectedProbes() const { return load.max / BLOCK_SLOTS; } // Blocks past the first of an average chain of max items
+    static unsigned int find(const Block& block, Key key); // Slot of the key in the block, BLOCK_SLOTS if absent
+    void insert(Key key, Value value); // Insert if not found key or update value if found key
+    void remove(Key key); // Remove if found key or do nothing if not found
+    ValueViewType search(Key key) { return searchFrom(key, hashFunction(key)); } // Return value if found, empty if not found
+    ValueViewType searchFrom(Key key, unsigned int index); // search() from an already hashed bucket
+    void searchBatch(const Key* keys, size_t n, ValueViewType* out); // out[i] = search(keys[i]), buckets of a batch are prefetched before scanning
+    void insertBatch(const Key* keys, const Value* values, size_t n); // insert() each item, buckets of a batch are prefetched first
+    Block* append(Block* tail, Key key, unsigned int item); // Add an item after the last one of the chain ending in tail, returns the new tail
+    void resize(unsigned int newSize); // Rebuild the blocks at once, entries stay where they are
+    void reserve(unsigned int n); // Grow once so n items fit under the max load factor, removes won't shrink below that
+    void input(const std::string& path, unsigned int n); // Only read the first n lines from the file (memory mapped)
+    unsigned int chainLength(unsigned int index) const; // Items in the bucket
+    unsigned int maxChainLength() const;
+    size_t memoryBytes() const; // Bytes of the blocks, overflow slabs and entries, not what the values allocate themselves
+    void outputStats(); // Output statistics of the hash table
+    void output(unsigned int n); // Output n items of the hash table
+};
+
+template <typename Hash, typename Key, typename Value>
+typename BucketChainHashTable<Hash, Key, Value>::Block* BucketChainHashTable<Hash, Key, Value>::BlockPool::allocate() {
+    if (freeList) { // Reuse a released block first
+        Block* block = freeList;
+        freeList = freeList->next;
+        block->next = nullptr;
+        return block;
+    }
+    if (slabUsed == SLAB_SIZE) {
+        slabs.emplace_back(new Block[SLAB_SIZE]);
+        slabUsed = 0;
+    }
+    return &slabs.back()[slabUsed++];
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::BlockPool::release(Block* block) {
+    block->used = 0;
+    block->next = freeList;
+    freeList = block;
+}
+
+template <typename Hash, typename Key, typename Value>
+BucketChainHashTable<Hash, Key, Value>::BucketChainHashTable(unsigned int size, Hash hash) : hash(hash), size(size), sizePower(log2(size)), table(size), load(4.0, size) {}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::resetStats() {
+    stats.reset();
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int BucketChainHashTable<Hash, Key, Value>::find(const Block& block, Key key) {
+    for (unsigned int slot = 0; slot < block.used; slot++) {
+        if (block.keys[slot] == key) return slot;
+    }
+    return BLOCK_SLOTS;
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::insert(Key key, Value value) {
+    if (load.grow(count)) resize(size * 2);
+    else if (rehashDue(hash, size)) resize(size);
+
+    Block* block = &table[hashFunction(key)];
+    unsigned int probes = 0; // Extra blocks scanned, for the stats
+    while (true) {
+        unsigned int slot = find(*block, key);
+        if (slot < BLOCK_SLOTS) {
+            entries[block->items[slot]].value = std::move(value); // Update value if key already exists
+            stats.recordHit(probes);
+            return;
+        }
+        if (!block->next) break;
+        block = block->next;
+        probes++;
+    }
+    stats.recordMiss(probes);
+    sampleProbes(hash, probes, *this);
+    append(block, key, count);
+    entries.push_back({key, std::move(value)});
+    count++;
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::remove(Key key) {
+    unsigned int index = hashFunction(key);
+    unsigned int probes = 0, slot = BLOCK_SLOTS; // Extra blocks scanned, for the stats
+    Block* block = &table[index];
+    Block* previous = nullptr;
+    while (block && (slot = find(*block, key)) == BLOCK_SLOTS) {
+        previous = block;
+        block = block->next;
+        probes++;
+    }
+    if (!block) {
+        stats.recordMiss(probes - 1);
+        return;
+    }
+    stats.recordHit(probes);
+    unsigned int item = block->items[slot];
+
+    // Fill the hole with the last item of the chain, so blocks stay packed
+    Block* tail = block;
+    while (tail->next) {
+        previous = tail;
+        tail = tail->next;
+    }
+    unsigned int last = --tail->used;
+    block->keys[slot] = tail->keys[last];
+    block->items[slot] = tail->items[last];
+    if (!tail->used && tail != &table[index]) { // Give an emptied overflow block back
+        previous->next = nullptr;
+        pool.release(tail);
+        overflowCount--;
+    }
+
+    // Same for entries, the slot pointing at the last entry is redirected to the hole
+    count--;
+    if (item != count) {
+        entries[item] = std::move(entries[count]);
+        for (Block* moved = &table[hashFunction(entries[item].key)]; moved; moved = moved->next) {
+            unsigned int movedSlot = find(*moved, entries[item].key);
+            if (movedSlot < BLOCK_SLOTS) {
+                moved->items[movedSlot] = item;
+                break;
+            }
+        }
+    }
+    entries.pop_back();
+    if (load.shrink(count, size)) resize(size / 2); // Halve once the load factor drops under the min limit
+}
+
+template <typename Hash, typename Key, typename Value>
+typename BucketChainHashTable<Hash, Key, Value>::ValueViewType BucketChainHashTable<Hash, Key, Value>::searchFrom(Key key, unsigned int index) {
+    const Block* block = &table[index];
+    unsigned int probes = 0; // Extra blocks scanned, for the stats
+    while (true) {
+        unsigned int slot = find(*block, key);
+        if (slot < BLOCK_SLOTS) { // Found
+            stats.recordHit(probes);
+            return entries[block->items[slot]].value;
+        }
+        if (!block->next) break;
+        block = block->next;
+        probes++;
+    }
+    stats.recordMiss(probes);
+    return ValueViewType(); // Not found
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::searchBatch(const Key* keys, size_t n, ValueViewType* out) {
+    unsigned int homes[BATCH_SIZE];
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) { // Hash the whole batch, the blocks of the buckets load in parallel
+            homes[i] = hashFunction(keys[begin + i]);
+            prefetch(&table[homes[i]]);
+        }
+        for (size_t i = 0; i < batch; i++) out[begin + i] = searchFrom(keys[begin + i], homes[i]);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::insertBatch(const Key* keys, const Value* values, size_t n) {
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) prefetch(&table[hashFunction(keys[begin + i])]);
+        for (size_t i = 0; i < batch; i++) insert(keys[begin + i], values[begin + i]); // Rehashes, a resize within the batch only wastes the prefetches
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+typename BucketChainHashTable<Hash, Key, Value>::Block* BucketChainHashTable<Hash, Key, Value>::append(Block* tail, Key key, unsigned int item) {
+    if (tail->used == BLOCK_SLOTS) { // Chain is full, link an overflow block
+        tail->next = pool.allocate();
+        tail = tail->next;
+        overflowCount++;
+    }
+    tail->keys[tail->used] = key;
+    tail->items[tail->used] = item;
+    tail->used++;
+    return tail;
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::resize(unsigned int newSize) {
+    adaptHash(hash, size);
+    if (newSize < size) entries.shrink_to_fit(); // Shrinking, give back the room of the removed entries too
+    table = std::vector<Block>(newSize);
+    pool = BlockPool();
+    overflowCount = 0;
+    sizePower = log2(newSize);
+    size = newSize;
+    load.update(size);
+
+    std::vector<Block*> tails(newSize); // Last block of each chain, saves walking them on every append
+    for (unsigned int i = 0; i < newSize; i++) tails[i] = &table[i];
+    for (unsigned int item = 0; item < count; item++) { // Entries in order, reads them front to back
+        unsigned int index = hashFunction(entries[item].key);
+        tails[index] = append(tails[index], entries[item].key, item);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::reserve(unsigned int n) {
+    load.reserve(n);
+    unsigned int newSize = load.fit(n, size);
+    if (newSize > size) resize(newSize);
+    entries.reserve(n);
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::input(const std::string& path, unsigned int n) {
+    bulkLoad(*this, path, n);
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int BucketChainHashTable<Hash, Key, Value>::chainLength(unsigned int index) const {
+    unsigned int length = 0;
+    for (const Block* block = &table[index]; block; block = block->next) length += block->used;
+    return length;
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int BucketChainHashTable<Hash, Key, Value>::maxChainLength() const {
+    unsigned int longest = 0;
+    for (unsigned int i = 0; i < size; i++) longest = std::max(longest, chainLength(i));
+    return longest;
+}
+
+template <typename Hash, typename Key, typename Value>
+size_t BucketChainHashTable<Hash, Key, Value>::memoryBytes() const {
+    return (table.capacity() + pool.slabs.size() * BlockPool::SLAB_SIZE) * sizeof(Block) + entries.capacity() * sizeof(Entry);
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::outputStats() {
+    std::cout << "\t\t---" << hash.name() << " Bucket Chain Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+    std::cout << "\n-Longest Chain: " << maxChainLength() << std::endl;
+    std::cout << "-Overflow Blocks: " << overflowCount << std::endl;
+    outputHash(hash);
+    stats.output();
+}
+
+template <typename Hash, typename Key, typename Value>
+void BucketChainHashTable<Hash, Key, Value>::output(unsigned int n) {
+    std::cout << "\t\t---" << hash.name() << " Bucket Chain Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+
+    for (unsigned int i = 0; i < n; i++) {
+        std::cout << std::endl << i << ": ";
+        if (!table[i].used) std::cout << "null";
+        for (const Block* block = &table[i]; block; block = block->next) {
+            if (block != &table[i]) std::cout << " -> "; // Overflow block
+            for (unsigned int slot = 0; slot < block->used; slot++) {
+                std::cout << (slot ? ", " : "") << block->keys[slot] << "|" << entries[block->items[slot]].value;
+            }
+        }
+    }
+    std::cout << "\n-Longest Chain: " << maxChainLength() << std::endl;
+    std::cout << "-Overflow Blocks: " << overflowCount << std::endl;
+    stats.output();
+}
+
+extern template struct BucketChainHashTable<FibonacciHash>;
+extern template struct BucketChainHashTable<ModuloHash>;
@@ -0,0 +1,108 @@
+#pragma once
+#include <mutex>
+#include <shared_mutex>
+#include "HashTable.hpp"
+
+//          --Concurrent, sharded--
+// Splits keys over 2^shardPower independent tables by the top bits of the Fibonacci hash.
+// Each shard has its own reader/writer lock: lookups share it and use the table's read-only lookup(),
+// inserts and removes take it exclusively, so threads only contend when they hit the same shard.
+// HashTableType is a LinearHashTable or ChainHashTable instantiation.
+template <typename HashTableType>
+struct ConcurrentHashTable {
+    using Key = typename HashTableType::KeyType;
+    using Value = typename HashTableType::ValueType;
+    struct alignas(64) Shard { // Own cache line, locks of neighbouring shards don't false share
+        mutable std::shared_mutex lock;
+        HashTableType table;
+
+        Shard(unsigned int size, unsigned int shardPower) : table(size) {
+            skipShardBits(table.hash, shardPower); // Index the shard with the product bits under the ones picking the shard
+        }
+    };
+    unsigned int shardPower;
+    std::vector<std::unique_ptr<Shard>> shards; // Pointers, a mutex can't be moved
+
+    ConcurrentHashTable(unsigned int size, unsigned int shardCount = 16) : shardPower(log2(shardCount)) {
+        for (unsigned int i = 0; i < (1u << shardPower); i++) {
+            shards.emplace_back(new Shard(std::max(size >> shardPower, 2u), shardPower));
+        }
+    }
+
+    unsigned int shardIndex(Key key) const { return shardPower ? fibonacciHash(key, shardPower) : 0; }
+    Shard& shardOf(Key key) const { return *shards[shardIndex(key)]; }
+
+    void resetStats() { // Clear the probe length histograms
+        for (auto& shard : shards) {
+            std::unique_lock<std::shared_mutex> guard(shard->lock);
+            shard->table.resetStats();
+        }
+    }
+
+    void insert(Key key, Value value) { // Insert if not found key or update value if found key
+        Shard& shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        shard.table.insert(key, std::move(value));
+    }
+
+    void remove(Key key) { // Remove if found key or do nothing if not found
+        Shard& shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        shard.table.remove(key);
+    }
+
+    Value search(Key key) const { // Return value if found, Value() if not found
+        Shard& shard = shardOf(key);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        return shard.table.lookup(key);
+    }
+
+    unsigned int itemCount() const {
+        unsigned int total = 0;
+        for (auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> guard(shard->lock);
+            total += shard->table.count;
+        }
+        return total;
+    }
+
+    void input(const std::string& path, unsigned int n) { // Only read the first n lines from the file, one thread per shard
+        MappedFile file(path);
+        if (!file.isOpen()) return;
+        unsigned int shardCount = shards.size();
+        auto records = partitionRecords<Key>(file, n, std::max(std::thread::hardware_concurrency(), 1u), shardCount, [&](Key key) { return shardIndex(key); });
+        std::vector<std::thread> threads;
+        for (unsigned int s = 0; s < shardCount; s++) {
+            threads.emplace_back([&, s]() {
+                Shard& shard = *shards[s];
+                std::unique_lock<std::shared_mutex> guard(shard.lock);
+                unsigned int total = shard.table.count;
+                for (auto& chunk : records) total += chunk[s].size();
+                shard.table.reserve(total);
+                for (auto& chunk : records) {
+                    for (const InputRecord<Key>& record : chunk[s]) shard.table.insert(record.key, parseValue<Value>(record.value));
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    void outputStats() { // Output statistics of the shards
+        unsigned int total = 0, smallest = ~0u, largest = 0;
+        ProbeStats stats; // All shards together
+        for (auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> guard(shard->lock);
+            stats.merge(shard->table.stats);
+            total += shard->table.count;
+            smallest = std::min(smallest, shard->table.count);
+            largest = std::max(largest, shard->table.count);
+        }
+        std::cout << "\t\t---" << shards[0]->table.hash.name() << " Concurrent Hash Table---\n"
+                  << "\tShards: " << shards.size() << "\tNumber of items: " << total << std::endl;
+        std::cout << "\n-Smallest Shard: " << smallest
+                  << "\n-Largest Shard: " << largest
+                  << "\n-Average Shard: " << total / float(shards.size()) << std::endl;
+        outputHash(shards[0]->table.hash); // Each shard adapts on its own, the first one stands in for the rest
+        stats.output();
+    }
+};
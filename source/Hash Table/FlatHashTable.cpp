@@ -0,0 +1,4 @@
+#include "FlatHashTable.hpp"
+
+template struct FlatLinearHashTable<FibonacciHash>;
+template struct FlatLinearHashTable<ModuloHash>;
@@ -0,0 +1,269 @@
+#pragma once
+#include <cstdint>
+#include "HashTable.hpp"
+
+//          --Open addressing, split layout--
+// Linear probing (grow when load factor > 0.7 by default) over a dense key array.
+// Probes only touch keys and occupancy bytes, values sit in a side array read on a match.
+template <typename Hash = ModuloHash, typename Key = unsigned int, typename Value = std::string>
+struct FlatLinearHashTable {
+    using KeyType = Key;
+    using ValueType = Value;
+    using ValueViewType = ValueView<Value>; // search() result, a string_view into the table for string values
+    Hash hash; // Hash policy, picks the home slot
+    unsigned int size, sizePower, count = 0;
+    std::vector<Key> keys; // UserIDs, 16 32-bit keys per 64-byte cache line
+    std::vector<uint8_t> occupied; // 1 if the slot holds a key, 0 if empty
+    std::vector<Value> values; // Passwords, values[i] belongs to keys[i]
+    ProbeStats stats; // Probe length histogram, empty unless built with HASH_TABLE_STATS
+    LoadFactor load; // Grow and shrink limits, 0.7 and 0.0875 unless set
+
+    FlatLinearHashTable(unsigned int size, Hash hash = Hash());
+
+    void resetStats(); // Clear the probe length histogram
+    unsigned int hashFunction(Key key) const { return hash(key, sizePower); } // Hashing method from the Hash policy
+    double expectedProbes() const { double free = 1 - load.max; return (1 / (free * free) - 1) / 2; } // Knuth's estimate for a miss under linear probing
+    void insert(Key key, Value value); // Insert if not found key or update value if found key
+    void remove(Key key); // Remove if found key or do nothing if not found
+    ValueViewType search(Key key) { return searchFrom(key, hashFunction(key)); } // Return value if found, empty if not found
+    ValueViewType searchFrom(Key key, unsigned int index); // search() from an already hashed home slot
+    void searchBatch(const Key* keys, size_t n, ValueViewType* out); // out[i] = search(keys[i]), home slots of a batch are prefetched before probing
+    void insertBatch(const Key* keys, const Value* values, size_t n); // insert() each item, home slots of a batch are prefetched first
+    void backwardShift(unsigned int hole); // Pull later items of the probe chain back into the freed slot
+    void resize(unsigned int newSize);
+    void reserve(unsigned int n); // Grow once so n items fit under the max load factor, removes won't shrink below that
+    void input(const std::string& path, unsigned int n); // Only read the first n lines from the file (memory mapped)
+    bool saveSnapshot(const std::string& path) const; // Write the slots to a binary snapshot, false if the file can't be written
+    bool loadSnapshot(const std::string& path); // Replace the contents with a snapshot, no rehashing if it was saved with the same hash policy
+    unsigned int displacement(unsigned int index) const { return (index - hashFunction(keys[index])) & (size - 1); } // Distance from the home slot
+    unsigned int maxDisplacement() const;
+    size_t memoryBytes() const; // Bytes of the key, occupancy and value arrays, not what the values allocate themselves
+    void outputStats(); // Output statistics of the hash table
+    void output(unsigned int n); // Output n items of the hash table
+};
+
+template <typename Hash, typename Key, typename Value>
+FlatLinearHashTable<Hash, Key, Value>::FlatLinearHashTable(unsigned int size, Hash hash) : hash(hash), size(size), sizePower(log2(size)), keys(size), occupied(size), values(size), load(0.7, size, 0.95) {}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::resetStats() {
+    stats.reset();
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::insert(Key key, Value value) {
+    if (load.grow(count)) resize(size * 2); // Resize if the load factor exceeds the max limit
+    else if (rehashDue(hash, size)) resize(size);
+
+    unsigned int index = hashFunction(key);
+    unsigned int probes = 0; // Extra slots probed, for the stats
+    while (occupied[index]) {
+        if (keys[index] == key) {
+            values[index] = std::move(value); // Update value if key already exists
+            stats.recordHit(probes);
+            return;
+        }
+        index = (index + 1) & (size - 1); // Linear probing
+        probes++;
+    }
+    stats.recordMiss(probes);
+    sampleProbes(hash, probes, *this);
+    keys[index] = key; // Insert new key-value pair
+    occupied[index] = 1;
+    values[index] = std::move(value);
+    count++;
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::remove(Key key) {
+    unsigned int index = hashFunction(key);
+    unsigned int probes = 0; // Extra slots probed, for the stats
+    while (occupied[index]) {
+        if (keys[index] == key) { // Found
+            occupied[index] = 0; // Remove the key
+            values[index] = Value();
+            count--;
+            backwardShift(index);
+            stats.recordHit(probes);
+            if (load.shrink(count, size)) resize(size / 2); // Halve once the load factor drops under the min limit
+            return;
+        }
+        index = (index + 1) & (size - 1); // Linear probing
+        probes++;
+    }
+    stats.recordMiss(probes);
+}
+
+template <typename Hash, typename Key, typename Value>
+typename FlatLinearHashTable<Hash, Key, Value>::ValueViewType FlatLinearHashTable<Hash, Key, Value>::searchFrom(Key key, unsigned int index) {
+    unsigned int probes = 0; // Extra slots probed, for the stats
+    while (occupied[index]) {
+        if (keys[index] == key) { // Found, the only access to the value array
+            stats.recordHit(probes);
+            return values[index];
+        }
+        index = (index + 1) & (size - 1); // Linear probing
+        probes++;
+    }
+    stats.recordMiss(probes);
+    return ValueViewType(); // Not found
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::searchBatch(const Key* searchKeys, size_t n, ValueViewType* out) {
+    unsigned int homes[BATCH_SIZE];
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) { // Hash the whole batch, the home slots load in parallel
+            homes[i] = hashFunction(searchKeys[begin + i]);
+            prefetch(&occupied[homes[i]]);
+            prefetch(&keys[homes[i]]);
+        }
+        for (size_t i = 0; i < batch; i++) out[begin + i] = searchFrom(searchKeys[begin + i], homes[i]);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::insertBatch(const Key* newKeys, const Value* newValues, size_t n) {
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) {
+            unsigned int home = hashFunction(newKeys[begin + i]);
+            prefetch(&occupied[home]);
+            prefetch(&keys[home]);
+        }
+        for (size_t i = 0; i < batch; i++) insert(newKeys[begin + i], newValues[begin + i]); // Rehashes, a resize within the batch only wastes the prefetches
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::backwardShift(unsigned int hole) {
+    unsigned int index = (hole + 1) & (size - 1);
+    while (occupied[index]) {
+        unsigned int home = hashFunction(keys[index]);
+        // Move the item back only if the hole lies between its home slot and its current slot
+        if (((index - home) & (size - 1)) >= ((index - hole) & (size - 1))) {
+            keys[hole] = keys[index];
+            occupied[hole] = 1;
+            values[hole] = std::move(values[index]);
+            occupied[index] = 0;
+            hole = index;
+        }
+        index = (index + 1) & (size - 1);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::resize(unsigned int newSize) {
+    adaptHash(hash, size);
+    std::vector<Key> oldKeys = std::move(keys);
+    std::vector<uint8_t> oldOccupied = std::move(occupied);
+    std::vector<Value> oldValues = std::move(values);
+    size = newSize;
+    sizePower = log2(newSize);
+    load.update(size);
+    keys.assign(newSize, 0);
+    occupied.assign(newSize, 0);
+    values = std::vector<Value>(newSize);
+
+    for (unsigned int i = 0; i < oldKeys.size(); i++) {
+        if (!oldOccupied[i]) continue;
+        unsigned int index = hashFunction(oldKeys[i]);
+        while (occupied[index]) index = (index + 1) & (size - 1); // Linear probing
+        keys[index] = oldKeys[i]; // Reinsert the item, moving its value
+        occupied[index] = 1;
+        values[index] = std::move(oldValues[i]);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::reserve(unsigned int n) {
+    load.reserve(n);
+    unsigned int newSize = load.fit(n, size);
+    if (newSize > size) resize(newSize);
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::input(const std::string& path, unsigned int n) {
+    bulkLoad(*this, path, n);
+}
+
+template <typename Hash, typename Key, typename Value>
+bool FlatLinearHashTable<Hash, Key, Value>::saveSnapshot(const std::string& path) const {
+    return writeSnapshot(path, "Flat Linear", hash, 0, size, count, 0, keys.data(), occupied.data(), values.data());
+}
+
+template <typename Hash, typename Key, typename Value>
+bool FlatLinearHashTable<Hash, Key, Value>::loadSnapshot(const std::string& path) {
+    MappedFile file(path);
+    SnapshotView view;
+    if (!openSnapshot<Key, Value>(file, "Flat Linear", view)) return false;
+    const SnapshotHeader& header = *view.header;
+    uint64_t items = 0; // The count must match the slots, and a slot must be empty for probes to stop
+    for (uint64_t i = 0; i < header.size; i++) {
+        if (view.states[i] > 1) return false;
+        items += view.states[i];
+    }
+    if (items != header.count || items >= header.size) return false;
+    if (sameHash(view, hash)) { // Same layout, copy the arrays as they are
+        loadHashState(view, hash);
+        size = header.size;
+        sizePower = log2(size);
+        load.update(size);
+        count = header.count;
+        keys.resize(size);
+        std::memcpy(keys.data(), view.keys, size * sizeof(Key));
+        occupied.assign(view.states, view.states + size);
+        readSnapshotValues(view, values);
+        return true;
+    }
+    LoadFactor limits = load; // Limits set on this table outlive its contents
+    *this = FlatLinearHashTable(header.size, hash); // Other hash policy, the items need new slots
+    load = limits;
+    load.update(size);
+    for (uint64_t i = 0; i < header.size; i++) {
+        if (view.states[i]) insert(snapshotKey<Key>(view, i), snapshotValue<Value>(view, i));
+    }
+    return true;
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int FlatLinearHashTable<Hash, Key, Value>::maxDisplacement() const {
+    unsigned int furthest = 0;
+    for (unsigned int i = 0; i < size; i++) {
+        if (occupied[i]) furthest = std::max(furthest, displacement(i));
+    }
+    return furthest;
+}
+
+template <typename Hash, typename Key, typename Value>
+size_t FlatLinearHashTable<Hash, Key, Value>::memoryBytes() const {
+    return keys.capacity() * sizeof(Key) + occupied.capacity() + values.capacity() * sizeof(Value);
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::outputStats() {
+    std::cout << "\t\t---" << hash.name() << " Flat Linear Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+    std::cout << "\n-Max Displacement: " << maxDisplacement() << std::endl;
+    outputHash(hash);
+    stats.output();
+}
+
+template <typename Hash, typename Key, typename Value>
+void FlatLinearHashTable<Hash, Key, Value>::output(unsigned int n) {
+    std::cout << "\t\t---" << hash.name() << " Flat Linear Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+
+    for (unsigned int i = 0; i < n; i++) {
+        std::cout << std::endl << i << ": ";
+        if (occupied[i]) std::cout << keys[i] << "|" << values[i];
+        else std::cout << "null";
+        if (occupied[i] && displacement(i)) std::cout << "\n\tDisplacement: " << displacement(i);
+    }
+    std::cout << "\n-Max Displacement: " << maxDisplacement() << std::endl;
+    stats.output();
+}
+
+extern template struct FlatLinearHashTable<FibonacciHash>;
+extern template struct FlatLinearHashTable<ModuloHash>;
@@ -0,0 +1,31 @@
+#include "HashPolicy.hpp"
+#include <iostream>
+
+const char* AdaptiveHash::modeName() const {
+    switch (mode) {
+    case Mode::Modulo: return "Modulo";
+    case Mode::Fibonacci: return "Fibonacci";
+    default: return seed ? "Murmur (reseeded)" : "Murmur";
+    }
+}
+
+bool AdaptiveHash::adapt(unsigned int size) {
+    if (!degenerate) return false;
+    degenerate = false;
+    probes = samples = 0; // New window for the rehashed table
+
+    if (mode == Mode::Modulo) mode = Mode::Fibonacci;
+    else if (mode == Mode::Fibonacci) mode = Mode::Murmur;
+    else seed = seed * 2654435769U + 0x9E3779B9U; // Any other seed spreads the same keys differently
+    switches++;
+    switchSize = size;
+    switchAverage = lastAverage;
+    return true;
+}
+
+void AdaptiveHash::output() const {
+    std::cout << "-Hash: " << modeName();
+    if (switches) std::cout << ", switched " << switches << " time(s), last at " << switchSize << " slots (average probe length " << switchAverage << " > " << limit << ")";
+    else std::cout << ", never switched";
+    std::cout << "\tAverage probe length of the last window: " << lastAverage << std::endl;
+}
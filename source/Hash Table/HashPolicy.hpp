@@ -0,0 +1,155 @@
+#pragma once
+#include <cstdint>
+
+        /*--Hash methods--*/
+// Inline so they fold into the probe loops, n is the power of 2 of the table size.
+// Keys are any unsigned integer type: up to 32 bits use 32-bit arithmetic, wider keys the 64-bit path.
+template <typename Key>
+inline uint64_t foldKey(Key key) { // Keys wider than 64 bits are folded into 64 by XOR of their 64-bit parts
+    if constexpr (sizeof(Key) <= 8) return uint64_t(key);
+    else {
+        uint64_t folded = 0;
+        for (unsigned int i = 0; i < sizeof(Key) / 8; i++, key >>= 64) folded ^= uint64_t(key);
+        return folded;
+    }
+}
+
+template <typename Key>
+inline unsigned int moduloHash(Key key, unsigned int size) {
+    return foldKey(key) & (size - 1); // Optimized modulo for power of 2 sizes
+}
+
+template <typename Key>
+inline unsigned int fibonacciHash(Key key, unsigned int n, unsigned int skip = 0) { // size is 2^n, skip top bits of the product
+    if constexpr (sizeof(Key) <= 4) return ((uint32_t(key) * 2654435769U) << skip) >> (32 - n); // 2^32 / golden ratio
+    else return ((foldKey(key) * 11400714819323198485ULL) << skip) >> (64 - n); // 2^64 / golden ratio
+}
+
+        /*--Hash policies--*/
+// Tables take one as a template parameter: policy(key, n) returns a slot index in [0, 2^n) and resolves at compile time.
+// Any type with the same operator() and name() can be plugged in.
+struct FibonacciHash {
+    unsigned int skip = 0; // Top product bits already used by an outer shard selector
+    template <typename Key>
+    unsigned int operator()(Key key, unsigned int n) const { return fibonacciHash(key, n, skip); }
+    const char* name() const { return "Fibonacci"; }
+};
+
+struct ModuloHash { // Low bits of the key, a mask since sizes are powers of 2
+    template <typename Key>
+    unsigned int operator()(Key key, unsigned int n) const { return moduloHash(key, 1u << n); }
+    const char* name() const { return "Modulo"; }
+};
+
+struct MultiplyShiftHash { // Fibonacci hashing with a chosen odd multiplier, e.g. a random one per table
+    uint64_t multiplier = 0xD6E8FEB86659FD93ULL; // Its low 32 bits are used for 32-bit keys
+    unsigned int skip = 0; // Top product bits already used by an outer shard selector
+    template <typename Key>
+    unsigned int operator()(Key key, unsigned int n) const {
+        if constexpr (sizeof(Key) <= 4) return ((uint32_t(key) * uint32_t(multiplier)) << skip) >> (32 - n);
+        else return ((foldKey(key) * multiplier) << skip) >> (64 - n);
+    }
+    const char* name() const { return "Multiply-Shift"; }
+};
+
+struct MurmurHash { // MurmurHash3 finalizers, every key bit affects every index bit
+    template <typename Key>
+    unsigned int operator()(Key key, unsigned int n) const {
+        if constexpr (sizeof(Key) <= 4) {
+            uint32_t mixed = uint32_t(key);
+            mixed ^= mixed >> 16;
+            mixed *= 0x85EBCA6BU;
+            mixed ^= mixed >> 13;
+            mixed *= 0xC2B2AE35U;
+            mixed ^= mixed >> 16;
+            return mixed >> (32 - n);
+        }
+        else {
+            uint64_t mixed = foldKey(key);
+            mixed ^= mixed >> 33;
+            mixed *= 0xFF51AFD7ED558CCDULL;
+            mixed ^= mixed >> 33;
+            mixed *= 0xC4CEB9FE1A85EC53ULL;
+            mixed ^= mixed >> 33;
+            return mixed >> (64 - n);
+        }
+    }
+    const char* name() const { return "Murmur"; }
+};
+
+// Starts on the cheap mask and moves to a stronger hash once the keys turn out to collide. Tables report the probe
+// length of every insert, averaged over windows of WINDOW inserts. How long probes get with well spread keys depends on
+// the table and its max load factor (linear probing expects about 5 extra probes at 0.7 and 50 at 0.9), so each table
+// reports that expectation and a window averaging over SLACK times it is degenerate (known early if its probes already
+// exceed limit * WINDOW). The table then rehashes, at its next growth or right away at the same size since a table sized
+// up front may never grow, but only once per size so keys no hash can spread don't rehash over and over.
+// adapt() switches Modulo -> Fibonacci -> Murmur, then reseeds Murmur. The rehash moves every item anyway.
+struct AdaptiveHash {
+    enum class Mode : uint8_t { Modulo, Fibonacci, Murmur };
+    static constexpr unsigned int WINDOW = 1024; // Inserts per sample window
+    static constexpr double SLACK = 4; // Times the expected probe length a window may average before it counts as degenerate
+    Mode mode = Mode::Modulo;
+    uint32_t seed = 0; // XORed into keys before Murmur, a new one on every switch past Murmur
+    unsigned int skip = 0; // Top product bits already used by an outer shard selector, skipped in Fibonacci mode
+    double limit = SLACK; // Average extra probes per insert that counts as degenerate, SLACK times the table's expectation
+    uint64_t probes = 0; // Extra probes of the inserts in the current window
+    unsigned int samples = 0; // Inserts in the current window
+    bool degenerate = false; // The last window averaged over limit, the table should rehash
+    double lastAverage = 0, switchAverage = 0; // Average probes of the last window and of the one that caused the last switch
+    unsigned int switches = 0, switchSize = 0; // Switches so far, table size at the last one
+
+    template <typename Key>
+    unsigned int operator()(Key key, unsigned int n) const {
+        switch (mode) {
+        case Mode::Modulo: return moduloHash(key, 1u << n);
+        case Mode::Fibonacci: return fibonacciHash(key, n, skip);
+        default: return MurmurHash()(key ^ Key(seed), n);
+        }
+    }
+    const char* name() const { return "Adaptive"; }
+    const char* modeName() const; // Hash in use
+    void sample(unsigned int probeLength) {
+        probes += probeLength;
+        samples++;
+        bool overBudget = probes > limit * WINDOW; // Already too many for a whole window, don't wait for it to fill
+        if (samples < WINDOW && !overBudget) return;
+        lastAverage = double(probes) / samples;
+        degenerate = overBudget || lastAverage > limit;
+        probes = samples = 0;
+    }
+    bool adapt(unsigned int size); // Called by a resize of a size slot table before it rehashes, true if the hash changed
+    void output() const; // Hash in use and the last switch
+};
+
+        /*--Table hooks--*/
+// Tables call these for every policy, only AdaptiveHash does something with them.
+// sampleProbes() takes the table, which has expectedProbes(): the average extra probes of an insert of a new key
+// with well spread keys at its max load factor.
+template <typename Hash, typename Table>
+inline void sampleProbes(Hash&, unsigned int, const Table&) {}
+template <typename Hash>
+inline void adaptHash(Hash&, unsigned int) {}
+template <typename Hash>
+inline bool rehashDue(const Hash&, unsigned int) { return false; }
+template <typename Hash>
+inline void outputHash(const Hash&) {}
+
+template <typename Table>
+inline void sampleProbes(AdaptiveHash& hash, unsigned int probes, const Table& table) {
+    if (hash.samples == 0) { // Once per window, the table's max load factor may have been changed
+        double expected = table.expectedProbes();
+        hash.limit = AdaptiveHash::SLACK * (expected > 1 ? expected : 1);
+    }
+    hash.sample(probes);
+}
+inline void adaptHash(AdaptiveHash& hash, unsigned int size) { hash.adapt(size); }
+inline bool rehashDue(const AdaptiveHash& hash, unsigned int size) { return hash.degenerate && hash.switchSize != size; } // One same-size rehash per size, later ones wait for a resize
+inline void outputHash(const AdaptiveHash& hash) { hash.output(); }
+
+// Shards of a ConcurrentHashTable are picked by the top bits of the Fibonacci product, policies that index with the
+// top bits of a product skip them so each shard's keys still spread over all of its slots
+template <typename Hash>
+inline void skipShardBits(Hash&, unsigned int) {}
+inline void skipShardBits(FibonacciHash& hash, unsigned int bits) { hash.skip = bits; }
+inline void skipShardBits(MultiplyShiftHash& hash, unsigned int bits) { hash.skip = bits; }
+inline void skipShardBits(AdaptiveHash& hash, unsigned int bits) { hash.skip = bits; }
@@ -1,63 +1,1015 @@
-#pragma once
-#include <iostream>
-#include <vector>
-#include <string>
-#include <fstream>
-#include <optional>
-#include <cmath>
-
-unsigned int moduloHash(const unsigned int& key, const unsigned int& size);
-unsigned int fibonacciHash(const unsigned int& key, const unsigned int& n); // size is 2^n
-
-//          --Open addressing--
-// Linear probing (resize when load factor > 0.7)
-struct LinearHashTable {
-    struct Node {
-        unsigned int key; // UserID
-        std::string value; // Password
-    };
-    bool useFibonacci; // Use Fibonacci hashing if true, modulo hashing if false
-    unsigned int size, sizePower, count = 0;
-    std::vector<std::optional<Node>> table;
-    std::vector<std::optional<unsigned int>> collisions; // Use to track max and average collision counts
-
-    LinearHashTable(unsigned int size, bool useFibonacci = false);
-
-    void resetCollisions(); // Reset collision counts
-    unsigned int hashFunction(const unsigned int& key); // Hashing method based on useFibonacci flag
-    void insert(unsigned int key, std::string value); // Insert if not found key or update value if found key
-    void remove(unsigned int key); // Remove if found key or do nothing if not found
-    std::string search(unsigned int key); // Return value if found, "" if not found
-    void resize(unsigned int newSize);
-    void input(const std::string& path, unsigned int n); // Only read the first n lines from the file
-    void outputStats(); // Output statistics of the hash table
-    void output(unsigned int n); // Output n items of the hash table
-};
-
-
-//          --Closed addressing--
-// Separate chaining (resize when load factor > 2)
-struct ChainHashTable {
-    struct Node {
-        unsigned int key; // UserID
-        std::string value; // Password
-        Node* next = nullptr;
-    };
-    bool useFibonacci; // Use Fibonacci hashing if true, modulo hashing if false
-    unsigned int size, sizePower, count = 0;
-    std::vector<Node*> table;
-    std::vector<std::optional<unsigned int>> collisions; // Use to track max and average collisions
-
-    ChainHashTable(unsigned int size, bool useFibonacci = false);
-    ~ChainHashTable(); // Destructor to vector of pounsigned inters Nodes
-
-    void resetCollisions(); // Reset collision counts
-    unsigned int hashFunction(const unsigned int& key); // Hashing method based on useFibonacci flag
-    void insert(unsigned int key, std::string value); // Insert if not found key or update value if found key
-    void remove(unsigned int key); // Remove if found key or do nothing if not found
-    std::string search(unsigned int key); // Return value if found, "" if not found
-    void resize(unsigned int newSize);
-    void input(const std::string& path, unsigned int n); // Only read the first n lines from the file
-    void outputStats(); // Output statistics of the hash table
-    void output(unsigned int n); // Output n items of the hash table
-};
\ No newline at end of file
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <optional>
+#include <cmath>
+#include <memory>
+#include <algorithm>
+#include "MappedFile.hpp"
+#include "HashPolicy.hpp"
+#include "ProbeStats.hpp"
+#include "Snapshot.hpp"
+#include "InlineString.hpp"
+#include "LoadFactor.hpp"
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <xmmintrin.h>
+#endif
+
+// Start loading the cache line at address without waiting for it, a hint only so any address is safe
+inline void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+constexpr unsigned int BATCH_SIZE = 16; // Keys hashed and prefetched together by searchBatch()/insertBatch(), about the cache misses a core keeps in flight
+
+//          --Open addressing--
+// Linear probing (grow when load factor > 0.7 by default), optionally Robin Hood ordered
+template <typename Hash = ModuloHash, typename Key = unsigned int, typename Value = std::string>
+struct LinearHashTable {
+    using KeyType = Key;
+    using ValueType = Value;
+    using ValueViewType = ValueView<Value>; // search() result, a string_view into the table for string values
+    enum class DeleteMode {
+        BackwardShift, // Shift the rest of the probe chain back into the freed slot (default)
+        Tombstone // Mark the freed slot as deleted, compact in place once too many tombstones pile up
+    };
+    enum class ProbeMode {
+        Linear, // New keys take the first free slot of their probe chain (default)
+        RobinHood // New keys take the slot of any item closer to its home, so a search stops once it is further from home than the resident
+    };
+    struct Node {
+        Key key; // UserID
+        Value value; // Password
+        unsigned int distance = 0; // Slots from the home slot, kept up to date in Robin Hood mode only
+    };
+    static constexpr unsigned int MIGRATE_STEP = 16; // Old slots migrated per insert/remove during an incremental resize
+
+    Hash hash; // Hash policy, picks the home slot
+    DeleteMode deleteMode; // Always BackwardShift in Robin Hood mode, tombstones would break the early exit
+    ProbeMode probeMode;
+    bool incrementalResize; // Grow by migrating a few slots per operation instead of rehashing everything at once
+    unsigned int size, sizePower, count = 0, tombstoneCount = 0; // count includes items still in oldTable
+    std::vector<std::optional<Node>> table;
+    std::vector<bool> tombstones; // True if the empty slot held a removed key (Tombstone mode only)
+    ProbeStats stats; // Probe length histogram, empty unless built with HASH_TABLE_STATS
+    LoadFactor load; // Grow and shrink limits, 0.7 and 0.0875 unless set
+    // Table being drained by an incremental resize, migrated slots become tombstones so old probe chains stay connected
+    std::vector<std::optional<Node>> oldTable;
+    std::vector<bool> oldTombstones;
+    unsigned int oldSize = 0, oldSizePower = 0, migrateIndex = 0;
+    Hash oldHash; // Hash policy oldTable was built with, an adaptive hash may switch when a resize begins
+
+    LinearHashTable(unsigned int size, DeleteMode deleteMode = DeleteMode::BackwardShift, bool incrementalResize = false, ProbeMode probeMode = ProbeMode::Linear, Hash hash = Hash());
+
+    void resetStats(); // Clear the probe length histogram
+    unsigned int hashFunction(Key key) const { return hash(key, sizePower); } // Hashing method from the Hash policy
+    double expectedProbes() const { double free = 1 - load.max; return (1 / (free * free) - 1) / 2; } // Knuth's estimate for a miss under linear probing
+    unsigned int oldHashFunction(Key key) const { return oldHash(key, oldSizePower); } // Hashing method oldTable was built with
+    bool isTombstone(unsigned int index) const { return deleteMode == DeleteMode::Tombstone && tombstones[index]; }
+    bool robinHood() const { return probeMode == ProbeMode::RobinHood; }
+    // Robin Hood mode: the key can't be at or after index if the resident there is closer to its home than the key would be
+    bool passedKey(unsigned int index, unsigned int distance) const { return robinHood() && table[index].value().distance < distance; }
+    void insert(Key key, Value value); // Insert if not found key or update value if found key
+    void remove(Key key); // Remove if found key or do nothing if not found
+    ValueViewType search(Key key) { return searchFrom(key, hashFunction(key)); } // Return value if found, empty if not found
+    ValueViewType searchFrom(Key key, unsigned int index); // search() from an already hashed home slot
+    void searchBatch(const Key* keys, size_t n, ValueViewType* out); // out[i] = search(keys[i]), home slots of a batch are prefetched before probing
+    void insertBatch(const Key* keys, const Value* values, size_t n); // insert() each item, home slots of a batch are prefetched first
+    Value lookup(Key key) const; // search() without collision tracking and returning a copy, safe for concurrent readers
+    void backwardShift(unsigned int hole); // Pull later items of the probe chain back into the freed slot
+    void compact(); // Rehash in place to clear all tombstones without reallocating
+    void resize(unsigned int newSize); // Rehash everything at once
+    void beginResize(unsigned int newSize); // Start an incremental resize, items move over in migrateStep()
+    bool migrating() const { return !oldTable.empty(); }
+    void migrateStep(); // Move the next MIGRATE_STEP slots of oldTable into table
+    std::optional<unsigned int> findOld(Key key) const; // Slot of the key in oldTable if not migrated yet
+    void place(Node&& item); // Put an item known to be absent into the first free slot of its probe chain
+    void robinHoodPlace(Node&& item, unsigned int index, unsigned int distance); // Put an absent item at index, displacing richer items down the chain
+    void shrinkIfSparse(); // Halve the size once a remove takes the load factor under the min limit
+    void reserve(unsigned int n); // Grow once so n items fit under the max load factor, removes won't shrink below that
+    void input(const std::string& path, unsigned int n); // Only read the first n lines from the file (memory mapped)
+    void parallelInput(const std::string& path, unsigned int n, unsigned int threadCount); // input() on threadCount threads
+    bool saveSnapshot(const std::string& path); // Finish any incremental resize and write the slots to a binary snapshot
+    bool loadSnapshot(const std::string& path); // Replace the contents with a snapshot, no rehashing if its hash policy and slot order fit this table
+    unsigned int displacement(unsigned int index) const; // Distance of the item in the slot from its home slot
+    unsigned int maxDisplacement() const;
+    std::pair<double, double> displacementMoments() const; // pair of <Mean, Variance> of the items' displacement
+    size_t memoryBytes() const; // Bytes of the slot arrays, old ones included, not what the values allocate themselves
+    void outputStats(); // Output statistics of the hash table
+    void output(unsigned int n); // Output n items of the hash table
+};
+
+
+//          --Closed addressing--
+// Separate chaining (grow when load factor > 2 by default)
+template <typename Hash = ModuloHash, typename Key = unsigned int, typename Value = std::string>
+struct ChainHashTable {
+    using KeyType = Key;
+    using ValueType = Value;
+    using ValueViewType = ValueView<Value>; // search() result, a string_view into the table for string values
+    struct Node {
+        Key key; // UserID
+        Value value; // Password
+        Node* next = nullptr;
+    };
+    // Slab allocator for chain nodes, removed nodes go on a free list and are reused before a new slab is taken
+    struct NodePool {
+        static constexpr unsigned int SLAB_SIZE = 4096; // Nodes per slab
+        std::vector<std::unique_ptr<Node[]>> slabs; // Owns every node, freed all at once with the table
+        Node* currentSlab = nullptr; // Slab new nodes are handed out from
+        unsigned int slabUsed = SLAB_SIZE; // Nodes handed out from currentSlab
+        Node* freeList = nullptr; // Released nodes, linked through next
+        size_t capacity = 0; // Nodes in all slabs, released ones included
+
+        Node* allocate(Key key, Value&& value, Node* next);
+        Node* allocateBlock(unsigned int n); // n fresh nodes in a slab of their own, one thread can fill them without locking
+        void release(Node* node);
+    };
+    static constexpr unsigned int MIGRATE_STEP = 8; // Old buckets relinked per insert/remove during an incremental resize
+
+    Hash hash; // Hash policy, picks the home slot
+    bool incrementalResize; // Grow by relinking a few buckets per operation instead of rehashing everything at once
+    unsigned int size, sizePower, count = 0; // count includes items still in oldTable
+    std::vector<Node*> table;
+    ProbeStats stats; // Probe length histogram, empty unless built with HASH_TABLE_STATS
+    NodePool pool; // Every node of table and oldTable lives here
+    LoadFactor load; // Grow and shrink limits, 2 and 0.25 unless set
+    std::vector<Node*> oldTable; // Buckets being drained by an incremental resize, buckets before migrateIndex are empty
+    unsigned int oldSize = 0, oldSizePower = 0, migrateIndex = 0;
+    Hash oldHash; // Hash policy oldTable was built with, an adaptive hash may switch when a resize begins
+
+    ChainHashTable(unsigned int size, bool incrementalResize = false, Hash hash = Hash());
+
+    void resetStats(); // Clear the probe length histogram
+    unsigned int hashFunction(Key key) const { return hash(key, sizePower); } // Hashing method from the Hash policy
+    double expectedProbes() const { return load.max; } // A miss walks the whole chain, max items on average
+    unsigned int oldHashFunction(Key key) const { return oldHash(key, oldSizePower); } // Hashing method oldTable was built with
+    void insert(Key key, Value value); // Insert if not found key or update value if found key
+    void remove(Key key); // Remove if found key or do nothing if not found
+    ValueViewType search(Key key) { return searchFrom(key, hashFunction(key)); } // Return value if found, empty if not found
+    ValueViewType searchFrom(Key key, unsigned int index); // search() from an already hashed bucket
+    void searchBatch(const Key* keys, size_t n, ValueViewType* out); // out[i] = search(keys[i]), buckets and first nodes of a batch are prefetched before walking
+    void insertBatch(const Key* keys, const Value* values, size_t n); // insert() each item, buckets of a batch are prefetched first
+    Value lookup(Key key) const; // search() without collision tracking and returning a copy, safe for concurrent readers
+    void resize(unsigned int newSize); // Rehash everything at once
+    void beginResize(unsigned int newSize); // Start an incremental resize, buckets move over in migrateStep()
+    bool migrating() const { return !oldTable.empty(); }
+    void migrateStep(); // Relink the next MIGRATE_STEP buckets of oldTable into table
+    void shrinkIfSparse(); // Halve the bucket count once a remove takes the load factor under the min limit
+    void reserve(unsigned int n); // Grow once so n items fit under the max load factor, removes won't shrink below that
+    void input(const std::string& path, unsigned int n); // Only read the first n lines from the file (memory mapped)
+    void parallelInput(const std::string& path, unsigned int n, unsigned int threadCount); // input() on threadCount threads
+    unsigned int chainLength(unsigned int index) const;
+    unsigned int maxChainLength() const;
+    size_t memoryBytes() const; // Bytes of the buckets and node slabs, free nodes included, not what the values allocate themselves
+    void outputStats(); // Output statistics of the hash table
+    void output(unsigned int n); // Output n items of the hash table
+};
+
+        /*--Open addressing--*/
+template <typename Hash, typename Key, typename Value>
+LinearHashTable<Hash, Key, Value>::LinearHashTable(unsigned int size, DeleteMode deleteMode, bool incrementalResize, ProbeMode probeMode, Hash hash) : hash(hash), deleteMode(probeMode == ProbeMode::RobinHood ? DeleteMode::BackwardShift : deleteMode), probeMode(probeMode), incrementalResize(incrementalResize), size(size), sizePower(log2(size)), table(size), tombstones(size), load(0.7, size, 0.95) {}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::resetStats() {
+    stats.reset();
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::insert(Key key, Value value) {
+    if (load.grow(count + tombstoneCount)) { // Resize if the load factor exceeds the max limit, tombstones take up slots as well
+        if (count <= load.growAt / 2 && !robinHood()) compact(); // Mostly tombstones, clearing them makes the room (compact() ignores Robin Hood order)
+        else if (incrementalResize) beginResize(size * 2);
+        else resize(size * 2);
+    }
+    else if (rehashDue(hash, size)) { // Keys collide under an adaptive hash, rehash at the same size with its next method
+        if (incrementalResize) beginResize(size);
+        else resize(size);
+    }
+    if (migrating()) migrateStep();
+    if (migrating()) {
+        if (std::optional<unsigned int> oldIndex = findOld(key)) {
+            oldTable[oldIndex.value()].value().value = std::move(value); // Update in place, it moves over with its slot
+            return;
+        }
+    }
+
+    unsigned int index = hashFunction(key);
+    unsigned int probes = 0; // Extra slots probed, for the stats
+    std::optional<unsigned int> firstTombstone; // First reusable slot on the probe chain
+    while(table[index] || isTombstone(index)) {
+        if (!table[index]) {
+            if (!firstTombstone) firstTombstone = index; // Keep probing, the key may still be further down the chain
+        }
+        else if (table[index].value().key == key) {
+            table[index].value().value = std::move(value); // Update value if key already exists
+            stats.recordHit(probes);
+            return;
+        }
+        else if (passedKey(index, probes)) break; // Not in the table, this is where it goes
+        index = (index + 1) % size; // Linear probing
+        probes++;
+    }
+    stats.recordMiss(probes);
+    sampleProbes(hash, probes, *this); // New key, tells an adaptive hash how well keys spread
+    count++;
+    if (robinHood()) {
+        robinHoodPlace(Node{key, std::move(value)}, index, probes);
+        return;
+    }
+    if (firstTombstone) { // Reuse the tombstone instead of extending the chain
+        index = firstTombstone.value();
+        tombstones[index] = false;
+        tombstoneCount--;
+    }
+    table[index] = Node{key, std::move(value)}; // Insert new key-value pair
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::remove(Key key) {
+    if (migrating()) migrateStep();
+    unsigned int index = hashFunction(key);
+    unsigned int probes = 0; // Extra slots probed, for the stats
+    while(table[index] || isTombstone(index)) {
+        if (table[index] && table[index].value().key == key) { // Found
+            table[index] = std::nullopt; // Remove the key
+            count--;
+            if (deleteMode == DeleteMode::BackwardShift) backwardShift(index);
+            else {
+                tombstones[index] = true; // Keep the probe chain connected
+                if (++tombstoneCount > size / 8) compact(); // Compact once tombstones take over 1/8 of the table
+            }
+            stats.recordHit(probes);
+            shrinkIfSparse();
+            return;
+        }
+        if (table[index] && passedKey(index, probes)) break;
+        index = (index + 1) % size; // Linear probing
+        probes++;
+    }
+    stats.recordMiss(probes);
+    if (!migrating()) return;
+    if (std::optional<unsigned int> oldIndex = findOld(key)) { // Not migrated yet
+        oldTable[oldIndex.value()] = std::nullopt;
+        oldTombstones[oldIndex.value()] = true;
+        count--;
+        shrinkIfSparse();
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+typename LinearHashTable<Hash, Key, Value>::ValueViewType LinearHashTable<Hash, Key, Value>::searchFrom(Key key, unsigned int index) {
+    unsigned int probes = 0; // Extra slots probed, for the stats
+    while(table[index] || isTombstone(index)) {
+        if (table[index] && table[index].value().key == key) { // Found
+            stats.recordHit(probes);
+            return table[index].value().value;
+        }
+        if (table[index] && passedKey(index, probes)) break;
+        index = (index + 1) % size; // Linear probing
+        probes++;
+    }
+    stats.recordMiss(probes);
+    if (migrating()) {
+        if (std::optional<unsigned int> oldIndex = findOld(key)) return oldTable[oldIndex.value()].value().value; // Found in the old table
+    }
+    return ValueViewType(); // Not found
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::searchBatch(const Key* keys, size_t n, ValueViewType* out) {
+    unsigned int homes[BATCH_SIZE];
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) { // Hash the whole batch, the home slots load in parallel
+            homes[i] = hashFunction(keys[begin + i]);
+            prefetch(&table[homes[i]]);
+        }
+        for (size_t i = 0; i < batch; i++) out[begin + i] = searchFrom(keys[begin + i], homes[i]);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::insertBatch(const Key* keys, const Value* values, size_t n) {
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) prefetch(&table[hashFunction(keys[begin + i])]);
+        for (size_t i = 0; i < batch; i++) insert(keys[begin + i], values[begin + i]); // Rehashes, a resize within the batch only wastes the prefetches
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+Value LinearHashTable<Hash, Key, Value>::lookup(Key key) const {
+    unsigned int index = hashFunction(key), distance = 0;
+    while(table[index] || isTombstone(index)) {
+        if (table[index] && table[index].value().key == key) return table[index].value().value; // Found
+        if (table[index] && passedKey(index, distance)) break;
+        index = (index + 1) % size; // Linear probing
+        distance++;
+    }
+    if (migrating()) {
+        if (std::optional<unsigned int> oldIndex = findOld(key)) return oldTable[oldIndex.value()].value().value; // Found in the old table
+    }
+    return Value(); // Not found
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::backwardShift(unsigned int hole) {
+    unsigned int index = (hole + 1) % size;
+    if (robinHood()) { // Chains are sorted by distance, shift until an item already sits in its home slot
+        while (table[index] && table[index].value().distance > 0) {
+            table[hole] = std::move(table[index]);
+            table[hole].value().distance--;
+            table[index] = std::nullopt;
+            hole = index;
+            index = (index + 1) % size;
+        }
+        return;
+    }
+    while (table[index]) {
+        unsigned int home = hashFunction(table[index].value().key);
+        // Move the item back only if the hole lies between its home slot and its current slot
+        if ((index + size - home) % size >= (index + size - hole) % size) {
+            table[hole] = std::move(table[index]);
+            table[index] = std::nullopt;
+            hole = index;
+        }
+        index = (index + 1) % size;
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::compact() {
+    unsigned int start = 0;
+    while (start < size && (table[start] || tombstones[start])) start++; // A truly empty slot, no probe chain runs across it
+    if (start == size) { // None left to start from, rebuild instead of rehashing in place
+        resize(size);
+        return;
+    }
+    tombstones.assign(size, false);
+    tombstoneCount = 0;
+
+    for (unsigned int step = 1; step <= size; step++) { // Walk the table once starting after that empty slot
+        unsigned int current = (start + step) % size;
+        if (!table[current]) continue;
+        Node item = std::move(table[current].value());
+        table[current] = std::nullopt;
+        unsigned int index = hashFunction(item.key); // Reinsert, lands at or before its current slot
+        while (table[index]) index = (index + 1) % size;
+        table[index] = std::move(item);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::resize(unsigned int newSize) {
+    while (migrating()) migrateStep(); // Finish an incremental resize first
+    adaptHash(hash, size); // Items are rehashed below, an adaptive hash may switch now
+    size = newSize;
+    sizePower = log2(newSize);
+    load.update(size);
+    std::vector<std::optional<Node>> oldTable = std::move(table);
+    table = std::vector<std::optional<Node>>(newSize);
+    tombstones.assign(newSize, false); // Tombstones are dropped by rehashing
+    tombstoneCount = 0;
+
+    for (auto& item : oldTable) {
+        if (item) {
+            place(std::move(item.value())); // Reinsert the item
+        }
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::beginResize(unsigned int newSize) {
+    while (migrating()) migrateStep(); // Finish the previous incremental resize first
+    oldHash = hash;
+    adaptHash(hash, size); // Only the new table uses a switched hash
+    oldTable = std::move(table);
+    oldTombstones = std::move(tombstones);
+    oldSize = size;
+    oldSizePower = sizePower;
+    migrateIndex = 0;
+
+    size = newSize;
+    sizePower = log2(newSize);
+    load.update(size);
+    table = std::vector<std::optional<Node>>(newSize);
+    tombstones.assign(newSize, false);
+    tombstoneCount = 0;
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::migrateStep() {
+    for (unsigned int step = 0; step < MIGRATE_STEP && migrateIndex < oldSize; step++, migrateIndex++) {
+        if (!oldTable[migrateIndex]) continue;
+        place(std::move(oldTable[migrateIndex].value()));
+        oldTable[migrateIndex] = std::nullopt;
+        oldTombstones[migrateIndex] = true; // Keys further down this old chain must still be reachable
+    }
+    if (migrateIndex == oldSize) { // Done, release the old table
+        std::vector<std::optional<Node>>().swap(oldTable);
+        std::vector<bool>().swap(oldTombstones);
+        oldSize = oldSizePower = migrateIndex = 0;
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+std::optional<unsigned int> LinearHashTable<Hash, Key, Value>::findOld(Key key) const {
+    unsigned int index = oldHashFunction(key);
+    while (oldTable[index] || oldTombstones[index]) {
+        if (oldTable[index] && oldTable[index].value().key == key) return index;
+        index = (index + 1) % oldSize; // Linear probing
+    }
+    return std::nullopt;
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::place(Node&& item) {
+    unsigned int index = hashFunction(item.key);
+    if (robinHood()) {
+        robinHoodPlace(std::move(item), index, 0);
+        return;
+    }
+    while (table[index]) index = (index + 1) % size; // Linear probing, a tombstone is free to reuse
+    if (isTombstone(index)) {
+        tombstones[index] = false;
+        tombstoneCount--;
+    }
+    table[index] = std::move(item);
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::robinHoodPlace(Node&& item, unsigned int index, unsigned int distance) {
+    item.distance = distance;
+    while (table[index]) {
+        if (table[index].value().distance < item.distance) std::swap(item, table[index].value()); // Take from the rich, carry on with the evicted item
+        index = (index + 1) % size; // Linear probing
+        item.distance++;
+    }
+    table[index] = std::move(item);
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::shrinkIfSparse() {
+    if (!load.shrink(count, size)) return;
+    if (incrementalResize) beginResize(size / 2);
+    else resize(size / 2);
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::reserve(unsigned int n) {
+    load.reserve(n);
+    unsigned int newSize = load.fit(n, size);
+    if (newSize > size) resize(newSize);
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::input(const std::string& path, unsigned int n) {
+    bulkLoad(*this, path, n);
+}
+
+template <typename Hash, typename Key, typename Value>
+bool LinearHashTable<Hash, Key, Value>::saveSnapshot(const std::string& path) {
+    while (migrating()) migrateStep();
+    std::vector<Key> keys(size);
+    std::vector<uint8_t> states(size); // 0 empty, 1 item, 2 tombstone
+    std::vector<Value> values(size);
+    for (unsigned int i = 0; i < size; i++) {
+        if (table[i]) {
+            keys[i] = table[i].value().key;
+            states[i] = 1;
+            values[i] = table[i].value().value;
+        }
+        else if (isTombstone(i)) states[i] = 2;
+    }
+    return writeSnapshot(path, "Linear", hash, robinHood() ? SNAPSHOT_ROBIN_HOOD : 0, size, count, tombstoneCount, keys.data(), states.data(), values.data());
+}
+
+template <typename Hash, typename Key, typename Value>
+bool LinearHashTable<Hash, Key, Value>::loadSnapshot(const std::string& path) {
+    MappedFile file(path);
+    SnapshotView view;
+    if (!openSnapshot<Key, Value>(file, "Linear", view)) return false;
+    const SnapshotHeader& header = *view.header;
+    uint64_t items = 0, deleted = 0; // The counts must match the slots, and a slot must be empty for probes to stop
+    for (uint64_t i = 0; i < header.size; i++) {
+        if (view.states[i] == 1) items++;
+        else if (view.states[i] == 2) deleted++;
+        else if (view.states[i]) return false;
+    }
+    if (items != header.count || deleted != header.deleted || items + deleted >= header.size) return false;
+    // A Robin Hood table needs Robin Hood order, tombstones only mean something in Tombstone mode
+    bool sameLayout = sameHash(view, hash) && (!robinHood() || (header.flags & SNAPSHOT_ROBIN_HOOD)) && (!header.deleted || deleteMode == DeleteMode::Tombstone);
+    if (sameLayout) loadHashState(view, hash);
+    LoadFactor limits = load; // Limits set on this table outlive its contents
+    *this = LinearHashTable(header.size, deleteMode, incrementalResize, probeMode, hash);
+    load = limits;
+    load.update(size);
+    if (!sameLayout) { // The items need new slots
+        for (uint64_t i = 0; i < header.size; i++) {
+            if (view.states[i] == 1) insert(snapshotKey<Key>(view, i), snapshotValue<Value>(view, i));
+        }
+        return true;
+    }
+    // Slots interleave key, value and distance, so the sections can't be copied into them as they are. Read the keys
+    // and raw values with one memcpy each, then fill the slots in a single pass.
+    std::vector<Key> keys(size);
+    std::memcpy(keys.data(), view.keys, size * sizeof(Key));
+    std::vector<Value> values;
+    readSnapshotValues(view, values);
+    for (unsigned int i = 0; i < size; i++) {
+        if (view.states[i] == 1) {
+            table[i] = Node{keys[i], std::move(values[i])};
+            if (robinHood()) table[i].value().distance = displacement(i);
+        }
+        else if (view.states[i] == 2) tombstones[i] = true;
+    }
+    count = header.count;
+    tombstoneCount = header.deleted;
+    return true;
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::parallelInput(const std::string& path, unsigned int n, unsigned int threadCount) {
+    if (robinHood()) { // Displaced items would cross into other threads' ranges
+        input(path, n);
+        return;
+    }
+    MappedFile file(path);
+    if (!file.isOpen()) return;
+    while (migrating()) migrateStep();
+    reserve(count + countLines(file.begin(), file.end(), n));
+
+    // Partition by the top bits of the home slot (the high bits of fibonacciHash), so each thread owns one slot range
+    unsigned int partitionPower = 0;
+    while ((2u << partitionPower) <= threadCount && partitionPower < sizePower) partitionPower++;
+    unsigned int partitions = 1u << partitionPower, shift = sizePower - partitionPower;
+    auto records = partitionRecords<Key>(file, n, threadCount, partitions, [&](Key key) { return hashFunction(key) >> shift; });
+
+    std::vector<std::vector<InputRecord<Key>>> overflow(partitions); // Probe chains running past the end of their range
+    std::vector<unsigned int> added(partitions, 0);
+    std::vector<std::thread> threads;
+    for (unsigned int p = 0; p < partitions; p++) {
+        threads.emplace_back([&, p]() {
+            unsigned int rangeEnd = (p + 1) << shift;
+            for (auto& chunk : records) {
+                for (const InputRecord<Key>& record : chunk[p]) {
+                    unsigned int index = hashFunction(record.key);
+                    while (index < rangeEnd && (table[index] || isTombstone(index))) {
+                        if (table[index] && table[index].value().key == record.key) break;
+                        index++; // Linear probing, no wrap around: slot 0 belongs to the first range
+                    }
+                    if (index == rangeEnd) overflow[p].push_back(record); // Leave it for the single threaded pass
+                    else if (table[index]) table[index].value().value = parseValue<Value>(record.value); // Update value if key already exists
+                    else {
+                        table[index] = Node{record.key, parseValue<Value>(record.value)};
+                        added[p]++;
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    for (unsigned int p = 0; p < partitions; p++) count += added[p];
+    for (auto& spilled : overflow) {
+        for (const InputRecord<Key>& record : spilled) insert(record.key, parseValue<Value>(record.value));
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int LinearHashTable<Hash, Key, Value>::displacement(unsigned int index) const {
+    return (index + size - hashFunction(table[index].value().key)) % size;
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int LinearHashTable<Hash, Key, Value>::maxDisplacement() const {
+    unsigned int furthest = 0;
+    for (unsigned int i = 0; i < size; i++) {
+        if (table[i]) furthest = std::max(furthest, displacement(i));
+    }
+    return furthest;
+}
+
+template <typename Hash, typename Key, typename Value>
+std::pair<double, double> LinearHashTable<Hash, Key, Value>::displacementMoments() const {
+    double sum = 0, squares = 0;
+    unsigned int items = 0;
+    for (unsigned int i = 0; i < size; i++) {
+        if (!table[i]) continue;
+        double distance = displacement(i);
+        sum += distance;
+        squares += distance * distance;
+        items++;
+    }
+    if (!items) return {0, 0};
+    double mean = sum / items;
+    return {mean, squares / items - mean * mean};
+}
+
+template <typename Hash, typename Key, typename Value>
+size_t LinearHashTable<Hash, Key, Value>::memoryBytes() const {
+    return (table.capacity() + oldTable.capacity()) * sizeof(std::optional<Node>) + (tombstones.capacity() + oldTombstones.capacity()) / 8;
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::outputStats() {
+    std::cout << "\t\t---" << hash.name() << " Linear Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+    if (deleteMode == DeleteMode::Tombstone) std::cout << "\tTombstones: " << tombstoneCount << std::endl;
+    if (robinHood()) std::cout << "\tProbing: Robin Hood" << std::endl;
+    if (migrating()) std::cout << "\tMigrating: " << migrateIndex << "/" << oldSize << " old slots" << std::endl;
+    std::pair<double, double> moments = displacementMoments();
+    std::cout << "\n-Max Displacement: " << maxDisplacement()
+              << "\n-Average Displacement: " << moments.first
+              << "\n-Displacement Variance: " << moments.second << std::endl;
+    outputHash(hash);
+    stats.output();
+}
+
+template <typename Hash, typename Key, typename Value>
+void LinearHashTable<Hash, Key, Value>::output(unsigned int n) {
+    std::cout << "\t\t---" << hash.name() << " Linear Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+
+    for (unsigned int i = 0; i < n; i++) {
+        std::cout << std::endl << i << ": ";
+        if (table[i]) std::cout << table[i].value().key << "|" << table[i].value().value;
+        else if (isTombstone(i)) std::cout << "deleted";
+        else std::cout << "null";
+        if (table[i] && displacement(i)) std::cout << "\n\tDisplacement: " << displacement(i);
+    }
+    std::cout << "\n-Max Displacement: " << maxDisplacement() << std::endl;
+    stats.output();
+}
+
+        /*--Closed addressing--*/
+template <typename Hash, typename Key, typename Value>
+typename ChainHashTable<Hash, Key, Value>::Node* ChainHashTable<Hash, Key, Value>::NodePool::allocate(Key key, Value&& value, Node* next) {
+    Node* node;
+    if (freeList) { // Reuse a released node first
+        node = freeList;
+        freeList = freeList->next;
+    }
+    else {
+        if (slabUsed == SLAB_SIZE) {
+            slabs.emplace_back(new Node[SLAB_SIZE]);
+            capacity += SLAB_SIZE;
+            currentSlab = slabs.back().get();
+            slabUsed = 0;
+        }
+        node = &currentSlab[slabUsed++];
+    }
+    node->key = key;
+    node->value = std::move(value);
+    node->next = next;
+    return node;
+}
+
+template <typename Hash, typename Key, typename Value>
+typename ChainHashTable<Hash, Key, Value>::Node* ChainHashTable<Hash, Key, Value>::NodePool::allocateBlock(unsigned int n) {
+    slabs.emplace_back(new Node[std::max(n, 1u)]);
+    capacity += std::max(n, 1u);
+    return slabs.back().get();
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::NodePool::release(Node* node) {
+    if constexpr (std::is_same_v<Value, std::string>) node->value.clear(); // Keep its buffer, the next value stored here can reuse it
+    else node->value = Value();
+    node->next = freeList;
+    freeList = node;
+}
+
+template <typename Hash, typename Key, typename Value>
+ChainHashTable<Hash, Key, Value>::ChainHashTable(unsigned int size, bool incrementalResize, Hash hash) : hash(hash), incrementalResize(incrementalResize), size(size), sizePower(log2(size)), table(size), load(2.0, size) {}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::resetStats() {
+    stats.reset();
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::insert(Key key, Value value) {
+    if (load.grow(count)) {
+        if (incrementalResize) beginResize(size * 2);
+        else resize(size * 2);
+    }
+    else if (rehashDue(hash, size)) {
+        if (incrementalResize) beginResize(size);
+        else resize(size);
+    }
+    if (migrating()) migrateStep();
+    if (migrating()) {
+        unsigned int oldIndex = oldHashFunction(key);
+        for (Node* current = oldIndex >= migrateIndex ? oldTable[oldIndex] : nullptr; current; current = current->next) {
+            if (current->key == key) {
+                current->value = std::move(value); // Update in place, it moves over with its bucket
+                return;
+            }
+        }
+    }
+
+    unsigned int index = hashFunction(key);
+    unsigned int probes = 0; // Extra nodes walked, for the stats
+    Node* current = table[index];
+    while(current) { // Check for alreay existing key
+        if (current->key == key) {
+            current->value = std::move(value); // Update value if key already exists
+            stats.recordHit(probes);
+            return;
+        }
+        current = current->next;
+        probes++;
+    }
+    stats.recordMiss(probes);
+    sampleProbes(hash, probes, *this);
+    table[index] = pool.allocate(key, std::move(value), table[index]);
+    count++;
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::remove(Key key) {
+    if (migrating()) migrateStep();
+    unsigned int index = hashFunction(key);
+    unsigned int probes = 0; // Extra nodes walked, for the stats
+    Node* current = table[index];
+    Node* prev = nullptr;
+    while(current) {
+        if (current && current->key == key) {
+            if (prev) prev->next = current->next; // Remove from chain
+            else table[index] = current->next; // Remove from head
+            pool.release(current);
+            count--;
+            stats.recordHit(probes);
+            shrinkIfSparse();
+            return;
+        }
+        prev = current;
+        current = current->next;
+        probes++;
+    }
+    stats.recordMiss(probes);
+    if (!migrating()) return;
+    unsigned int oldIndex = oldHashFunction(key);
+    if (oldIndex < migrateIndex) return; // Bucket already migrated
+    for (Node** link = &oldTable[oldIndex]; *link; link = &(*link)->next) {
+        if ((*link)->key == key) { // Not migrated yet
+            Node* toDelete = *link;
+            *link = toDelete->next;
+            pool.release(toDelete);
+            count--;
+            shrinkIfSparse();
+            return;
+        }
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+typename ChainHashTable<Hash, Key, Value>::ValueViewType ChainHashTable<Hash, Key, Value>::searchFrom(Key key, unsigned int index) {
+    unsigned int probes = 0; // Extra nodes walked, for the stats
+    Node* current = table[index];
+    while(current) {
+        if (current->key == key) { // Found
+            stats.recordHit(probes);
+            return current->value;
+        }
+        current = current->next;
+        probes++;
+    }
+    stats.recordMiss(probes);
+    if (migrating()) {
+        unsigned int oldIndex = oldHashFunction(key);
+        for (current = oldIndex >= migrateIndex ? oldTable[oldIndex] : nullptr; current; current = current->next) {
+            if (current->key == key) return current->value; // Found in the old table
+        }
+    }
+    return ValueViewType(); // Not found
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::searchBatch(const Key* keys, size_t n, ValueViewType* out) {
+    unsigned int homes[BATCH_SIZE];
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) { // Hash the whole batch, the buckets load in parallel
+            homes[i] = hashFunction(keys[begin + i]);
+            prefetch(&table[homes[i]]);
+        }
+        for (size_t i = 0; i < batch; i++) prefetch(table[homes[i]]); // Then the first node of every chain
+        for (size_t i = 0; i < batch; i++) out[begin + i] = searchFrom(keys[begin + i], homes[i]);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::insertBatch(const Key* keys, const Value* values, size_t n) {
+    unsigned int homes[BATCH_SIZE];
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) {
+            homes[i] = hashFunction(keys[begin + i]);
+            prefetch(&table[homes[i]]);
+        }
+        for (size_t i = 0; i < batch; i++) prefetch(table[homes[i]]); // The chain is walked for an existing key
+        for (size_t i = 0; i < batch; i++) insert(keys[begin + i], values[begin + i]); // Rehashes, a resize within the batch only wastes the prefetches
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+Value ChainHashTable<Hash, Key, Value>::lookup(Key key) const {
+    for (Node* current = table[hashFunction(key)]; current; current = current->next) {
+        if (current->key == key) return current->value; // Found
+    }
+    if (migrating()) {
+        unsigned int oldIndex = oldHashFunction(key);
+        for (Node* current = oldIndex >= migrateIndex ? oldTable[oldIndex] : nullptr; current; current = current->next) {
+            if (current->key == key) return current->value; // Found in the old table
+        }
+    }
+    return Value(); // Not found
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::resize(unsigned int newSize) {
+    while (migrating()) migrateStep(); // Finish an incremental resize first
+    adaptHash(hash, size);
+    std::vector<Node*> oldBuckets = std::move(table);
+    table.assign(newSize, nullptr); // A fresh array, a shrunk table gives the old one back
+    sizePower = log2(newSize);
+    size = newSize;
+    load.update(size);
+
+    for (Node* head : oldBuckets) {
+        Node* current = head;
+        while (current) { // Relink the nodes, no reallocation
+            Node* next = current->next;
+            unsigned int index = hashFunction(current->key);
+            current->next = table[index];
+            table[index] = current;
+            current = next;
+        }
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::beginResize(unsigned int newSize) {
+    while (migrating()) migrateStep(); // Finish the previous incremental resize first
+    oldHash = hash;
+    adaptHash(hash, size);
+    oldTable = std::move(table);
+    oldSize = size;
+    oldSizePower = sizePower;
+    migrateIndex = 0;
+
+    table.assign(newSize, nullptr);
+    sizePower = log2(newSize);
+    size = newSize;
+    load.update(size);
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::migrateStep() {
+    for (unsigned int step = 0; step < MIGRATE_STEP && migrateIndex < oldSize; step++, migrateIndex++) {
+        Node* current = oldTable[migrateIndex];
+        oldTable[migrateIndex] = nullptr;
+        while (current) { // Relink the nodes, no reallocation
+            Node* next = current->next;
+            unsigned int index = hashFunction(current->key);
+            current->next = table[index];
+            table[index] = current;
+            current = next;
+        }
+    }
+    if (migrateIndex == oldSize) { // Done, release the old buckets
+        std::vector<Node*>().swap(oldTable);
+        oldSize = oldSizePower = migrateIndex = 0;
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::shrinkIfSparse() {
+    if (!load.shrink(count, size)) return;
+    if (incrementalResize) beginResize(size / 2);
+    else resize(size / 2);
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::reserve(unsigned int n) {
+    load.reserve(n);
+    unsigned int newSize = load.fit(n, size);
+    if (newSize > size) resize(newSize);
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::input(const std::string& path, unsigned int n) {
+    bulkLoad(*this, path, n);
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::parallelInput(const std::string& path, unsigned int n, unsigned int threadCount) {
+    MappedFile file(path);
+    if (!file.isOpen()) return;
+    while (migrating()) migrateStep();
+    reserve(count + countLines(file.begin(), file.end(), n));
+
+    // Partition by the top bits of the bucket index (the high bits of fibonacciHash), so each thread owns one bucket range
+    unsigned int partitionPower = 0;
+    while ((2u << partitionPower) <= threadCount && partitionPower < sizePower) partitionPower++;
+    unsigned int partitions = 1u << partitionPower, shift = sizePower - partitionPower;
+    auto records = partitionRecords<Key>(file, n, threadCount, partitions, [&](Key key) { return hashFunction(key) >> shift; });
+
+    std::vector<Node*> blocks(partitions); // Nodes for each thread, taken from the pool up front
+    std::vector<unsigned int> added(partitions, 0), reserved(partitions, 0);
+    for (unsigned int p = 0; p < partitions; p++) {
+        for (auto& chunk : records) reserved[p] += chunk[p].size();
+        blocks[p] = pool.allocateBlock(reserved[p]);
+    }
+    std::vector<std::thread> threads;
+    for (unsigned int p = 0; p < partitions; p++) {
+        threads.emplace_back([&, p]() {
+            for (auto& chunk : records) {
+                for (const InputRecord<Key>& record : chunk[p]) {
+                    unsigned int index = hashFunction(record.key);
+                    Node* current = table[index];
+                    while (current && current->key != record.key) current = current->next; // Check for already existing key
+                    if (current) current->value = parseValue<Value>(record.value); // Update value if key already exists
+                    else {
+                        Node* newNode = &blocks[p][added[p]++];
+                        newNode->key = record.key;
+                        newNode->value = parseValue<Value>(record.value);
+                        newNode->next = table[index];
+                        table[index] = newNode;
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    for (unsigned int p = 0; p < partitions; p++) {
+        count += added[p];
+        for (unsigned int i = added[p]; i < reserved[p]; i++) pool.release(&blocks[p][i]); // Nodes left over by duplicate keys
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int ChainHashTable<Hash, Key, Value>::chainLength(unsigned int index) const {
+    unsigned int length = 0;
+    for (Node* current = table[index]; current; current = current->next) length++;
+    return length;
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int ChainHashTable<Hash, Key, Value>::maxChainLength() const {
+    unsigned int longest = 0;
+    for (unsigned int i = 0; i < size; i++) longest = std::max(longest, chainLength(i));
+    return longest;
+}
+
+template <typename Hash, typename Key, typename Value>
+size_t ChainHashTable<Hash, Key, Value>::memoryBytes() const {
+    return (table.capacity() + oldTable.capacity()) * sizeof(Node*) + pool.capacity * sizeof(Node);
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::outputStats() {
+    std::cout << "\t\t---" << hash.name() << " Chain Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+    if (migrating()) std::cout << "\tMigrating: " << migrateIndex << "/" << oldSize << " old buckets" << std::endl;
+    std::cout << "\n-Longest Chain: " << maxChainLength() << std::endl;
+    outputHash(hash);
+    stats.output();
+}
+
+template <typename Hash, typename Key, typename Value>
+void ChainHashTable<Hash, Key, Value>::output(unsigned int n) {
+    std::cout << "\t\t---" << hash.name() << " Chain Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+
+    for (unsigned int i = 0; i < n; i++) {
+        std::cout << std::endl << i << ": ";
+
+        if (table[i]) {
+            std::cout << table[i]->key << "|" << table[i]->value;
+            Node* current = table[i]->next;
+            while (current) {
+                std::cout << " -> " << current->key << "|" << current->value;
+                current = current->next;
+            }
+        }
+        else std::cout << "null";
+    }
+    std::cout << "\n-Longest Chain: " << maxChainLength() << std::endl;
+    stats.output();
+}
+
+// Default instantiations are compiled once in HashTable.cpp
+extern template struct LinearHashTable<FibonacciHash>;
+extern template struct LinearHashTable<ModuloHash>;
+extern template struct ChainHashTable<FibonacciHash>;
+extern template struct ChainHashTable<ModuloHash>;
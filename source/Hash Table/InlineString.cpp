@@ -0,0 +1,57 @@
+#include "InlineString.hpp"
+#include <stdexcept>
+
+StringArena::~StringArena() {
+    for (uint32_t i = 0; i < chunkCount; i++) delete[] chunks[i].load();
+}
+
+StringArena& StringArena::shared() {
+    static StringArena arena;
+    return arena;
+}
+
+void StringArena::append(std::string_view text, uint32_t& chunk, uint32_t& offset) {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (chunkCount == MAX_CHUNKS) throw std::length_error("StringArena is full");
+    totalBytes += text.size();
+    if (text.size() > CHUNK_SIZE) { // A block of its own, the current one keeps filling up
+        char* block = new char[text.size()];
+        std::memcpy(block, text.data(), text.size());
+        chunks[chunkCount].store(block, std::memory_order_release);
+        chunk = chunkCount++;
+        offset = 0;
+        return;
+    }
+    if (used + text.size() > CHUNK_SIZE) { // Start a new block
+        chunks[chunkCount].store(new char[CHUNK_SIZE], std::memory_order_release);
+        current = chunkCount++;
+        used = 0;
+    }
+    std::memcpy(chunks[current].load(std::memory_order_relaxed) + used, text.data(), text.size());
+    chunk = current;
+    offset = used;
+    used += text.size();
+}
+
+InlineString::InlineString(std::string_view text) {
+    if (text.size() <= CAPACITY) {
+        std::memcpy(buffer, text.data(), text.size());
+        length = uint8_t(text.size());
+        return;
+    }
+    uint32_t location[3] = {0, 0, uint32_t(text.size())}; // chunk, offset, length
+    StringArena::shared().append(text, location[0], location[1]);
+    std::memcpy(buffer, location, sizeof(location));
+    length = SPILLED;
+}
+
+std::string_view InlineString::view() const {
+    if (!spilled()) return std::string_view(buffer, length);
+    uint32_t location[3];
+    std::memcpy(location, buffer, sizeof(location));
+    return std::string_view(StringArena::shared().at(location[0], location[1]), location[2]);
+}
+
+std::ostream& operator<<(std::ostream& out, const InlineString& text) {
+    return out << text.view();
+}
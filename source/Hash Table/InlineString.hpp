@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+// Append-only storage for InlineString values too long to fit inline, shared by every table.
+// Memory is taken in CHUNK_SIZE blocks that never move or get freed, so views into them stay valid.
+// The space of long values that were removed or overwritten is not reused.
+struct StringArena {
+    static constexpr uint32_t CHUNK_SIZE = 1 << 20; // Bytes per block, longer strings get a block of their own
+    static constexpr uint32_t MAX_CHUNKS = 1 << 16;
+    std::atomic<char*> chunks[MAX_CHUNKS] = {}; // Read without the lock, a chunk is published before any string in it
+    uint32_t chunkCount = 0, current = 0, used = CHUNK_SIZE; // Strings are appended to chunks[current], used bytes of it
+    uint64_t totalBytes = 0; // Characters stored
+    std::mutex mutex; // Appends come from parallelInput() threads and ConcurrentHashTable writers
+
+    StringArena() = default;
+    ~StringArena();
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    static StringArena& shared();
+    void append(std::string_view text, uint32_t& chunk, uint32_t& offset); // Copy text in, chunk and offset tell where it went
+    const char* at(uint32_t chunk, uint32_t offset) const { return chunks[chunk].load(std::memory_order_acquire) + offset; }
+};
+
+// Value type for short strings like passwords: up to CAPACITY characters live in the object itself,
+// longer ones in StringArena::shared() referenced by chunk and offset. No heap allocation per value and
+// trivially copyable, so resizes move it with plain copies.
+struct InlineString {
+    static constexpr uint8_t CAPACITY = 15;
+    static constexpr uint8_t SPILLED = 0xFF; // length of a string stored in the arena
+    char buffer[CAPACITY] = {}; // Characters, or the chunk, offset and length of a spilled string
+    uint8_t length = 0; // Characters stored inline, or SPILLED
+
+    InlineString() = default;
+    InlineString(std::string_view text);
+    InlineString(const char* text) : InlineString(std::string_view(text)) {}
+    InlineString(const std::string& text) : InlineString(std::string_view(text)) {}
+
+    std::string_view view() const;
+    operator std::string_view() const { return view(); }
+    bool spilled() const { return length == SPILLED; }
+    bool empty() const { return length == 0; } // Only non-empty strings spill
+    size_t size() const { return view().size(); }
+    bool operator==(const InlineString& other) const { return view() == other.view(); }
+    bool operator!=(const InlineString& other) const { return view() != other.view(); }
+};
+
+std::ostream& operator<<(std::ostream& out, const InlineString& text);
+
+// What search() returns: a view into the table for string-like values, valid until the table is next modified,
+// so a hit doesn't allocate or copy. Other values are returned by copy.
+template <typename Value>
+using ValueView = std::conditional_t<std::is_convertible_v<const Value&, std::string_view>, std::string_view, Value>;
@@ -0,0 +1,46 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <optional>
+
+/*      -- Load factor limits --
+A table grows to twice its size once count / size goes over max, and shrinks to half its size once it drops under min.
+min is capped at max / 4: a table that just shrank is at most half way to growing again and one that just grew is
+twice min away from shrinking, so a workload hovering around either limit does not resize back and forth.
+The limits are kept as item counts for the current size, inserts and removes compare integers instead of dividing.
+An insert grows the table first if it would take count over growAt, so count never passes it. Under a ceiling below 1
+growAt = floor(max * size) is under size, so at least one slot stays empty and every probe chain ends.
+*/
+struct LoadFactor {
+    double max, min; // Grow over max, shrink under min (0 never shrinks)
+    double ceiling; // Highest max allowed, open addressing keeps it under 1 so every probe still ends at an empty slot
+    unsigned int floor; // Never shrink below this size: the initial size, or more if reserve() asked for it
+    unsigned int growAt = 0, shrinkAt = 0; // max and min as item counts for the current size
+
+    LoadFactor(double max, unsigned int size, double ceiling = HUGE_VAL) : ceiling(ceiling), floor(size) { set(max, max / 8, size); }
+
+    void set(double newMax, double newMin, unsigned int size) {
+        max = std::min(newMax, ceiling);
+        min = std::clamp(newMin, 0.0, max / 4);
+        update(size);
+    }
+    void update(unsigned int size) { // Call after every change of size
+        growAt = static_cast<unsigned int>(std::min(std::floor(max * size), double(UINT_MAX)));
+        shrinkAt = static_cast<unsigned int>(std::ceil(min * size));
+    }
+    bool grow(unsigned int count) const { return count >= growAt; } // Before an insert: one more item would go over max
+    bool shrink(unsigned int count, unsigned int size) const { return count < shrinkAt && size / 2 >= floor; }
+    unsigned int fit(unsigned int n, unsigned int size) const { // Smallest size from size up, doubling, that holds n items under max
+        while (n > max * size) size *= 2; // Keep the size a power of 2
+        return size;
+    }
+    void reserve(unsigned int n) { floor = fit(n, floor); } // Removes won't shrink the table below the size n items need
+};
+
+// Override a table's limits, an unset max keeps the table's default and an unset min follows max as in the constructor
+template <typename HashTableType>
+void setLoadFactor(HashTableType& hashTable, std::optional<double> max, std::optional<double> min) {
+    double newMax = max.value_or(hashTable.load.max);
+    hashTable.load.set(newMax, min.value_or(newMax / 8), hashTable.size);
+}
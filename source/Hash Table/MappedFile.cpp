@@ -0,0 +1,62 @@
+#include "MappedFile.hpp"
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path) {
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        fileHandle = nullptr;
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) return;
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) return;
+    data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (data) length = size_t(fileSize.QuadPart);
+}
+
+MappedFile::~MappedFile() {
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+}
+#else
+MappedFile::MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            data = static_cast<const char*>(mapping);
+            length = info.st_size;
+            madvise(mapping, length, MADV_SEQUENTIAL); // Read once front to back
+        }
+    }
+    close(fd); // The mapping stays valid after closing
+}
+
+MappedFile::~MappedFile() {
+    if (data) munmap(const_cast<char*>(data), length);
+}
+#endif
+
+unsigned int countLines(const char* begin, const char* end, unsigned int n) {
+    unsigned int lines = 0;
+    while (begin < end && lines < n) {
+        const char* newline = static_cast<const char*>(memchr(begin, '\n', end - begin));
+        lines++; // Also counts a last line without a newline
+        if (!newline) break;
+        begin = newline + 1;
+    }
+    return lines;
+}
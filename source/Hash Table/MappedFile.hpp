@@ -0,0 +1,109 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <charconv>
+#include <type_traits>
+
+// Read-only memory mapping of a whole file (mmap on POSIX, a mapped view on Windows)
+struct MappedFile {
+    const char* data = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+    MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return data != nullptr; }
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+};
+
+template <typename Key>
+struct InputRecord {
+    Key key; // UserID
+    std::string_view value; // Password, points into the mapped file
+};
+
+unsigned int countLines(const char* begin, const char* end, unsigned int n); // Number of lines in the range, stops at n
+
+template <typename Key>
+bool parseRecord(const char*& cursor, const char* end, Key& key, std::string_view& value) { // Parse one "key value" line, false at the end
+    while (cursor < end && (*cursor < '0' || *cursor > '9')) cursor++; // Skip blank lines and spaces
+    if (cursor == end) return false;
+    key = 0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') key = key * 10 + Key(*cursor++ - '0');
+
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) cursor++;
+    const char* valueStart = cursor;
+    while (cursor < end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n') cursor++;
+    value = std::string_view(valueStart, cursor - valueStart);
+    while (cursor < end && *cursor != '\n') cursor++; // Ignore the rest of the line
+    return true;
+}
+
+template <typename Value>
+Value parseValue(std::string_view text) { // Build a table value from its text in the file
+    if constexpr (std::is_constructible_v<Value, std::string_view>) return Value(text);
+    else {
+        static_assert(std::is_arithmetic_v<Value>, "Loading from a file needs a string-like or arithmetic value type");
+        Value value{};
+        std::from_chars(text.data(), text.data() + text.size(), value);
+        return value;
+    }
+}
+
+// Load the first n lines of a "key value" file into any hash table: map the file, reserve the final size, then insert
+template <typename HashTableType>
+void bulkLoad(HashTableType& hashTable, const std::string& path, unsigned int n) {
+    MappedFile file(path);
+    if (!file.isOpen()) return;
+    hashTable.reserve(hashTable.count + countLines(file.begin(), file.end(), n)); // No resize while inserting
+
+    const char* cursor = file.begin();
+    typename HashTableType::KeyType key;
+    std::string_view value;
+    while (n-- > 0 && parseRecord(cursor, file.end(), key, value)) {
+        hashTable.insert(key, parseValue<typename HashTableType::ValueType>(value)); // Passwords fit the small string buffer, no heap allocation
+    }
+}
+
+// Parse the first n lines on threadCount threads and bucket the records with partitionOf(key).
+// Returns records[chunk][partition], chunks follow file order so reading them in order keeps the last value of a key last.
+template <typename Key, typename PartitionFunction>
+std::vector<std::vector<std::vector<InputRecord<Key>>>> partitionRecords(const MappedFile& file, unsigned int n, unsigned int threadCount, unsigned int partitions, PartitionFunction partitionOf) {
+    const char* stop = file.begin(); // End of line n
+    for (unsigned int lines = 0; lines < n && stop < file.end(); lines++) {
+        const char* newline = static_cast<const char*>(memchr(stop, '\n', file.end() - stop));
+        stop = newline ? newline + 1 : file.end();
+    }
+    threadCount = std::max(threadCount, 1u);
+    std::vector<const char*> cuts(threadCount + 1, stop); // Chunk t is [cuts[t], cuts[t + 1]), cut at line starts
+    cuts[0] = file.begin();
+    for (unsigned int t = 1; t < threadCount; t++) {
+        const char* cut = std::max(cuts[t - 1], file.begin() + (stop - file.begin()) / threadCount * t);
+        while (cut > file.begin() && cut < stop && cut[-1] != '\n') cut++;
+        cuts[t] = cut;
+    }
+
+    std::vector<std::vector<std::vector<InputRecord<Key>>>> records(threadCount, std::vector<std::vector<InputRecord<Key>>>(partitions));
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t]() {
+            const char* cursor = cuts[t];
+            InputRecord<Key> record;
+            while (parseRecord(cursor, cuts[t + 1], record.key, record.value)) records[t][partitionOf(record.key)].push_back(record);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    return records;
+}
@@ -0,0 +1,55 @@
+#include "ProbeStats.hpp"
+#include <iostream>
+
+uint64_t ProbeStats::total(const std::vector<uint64_t>& histogram) {
+    uint64_t count = 0;
+    for (uint64_t bucket : histogram) count += bucket;
+    return count;
+}
+
+double ProbeStats::average(const std::vector<uint64_t>& histogram) {
+    uint64_t count = 0, sum = 0;
+    for (unsigned int probes = 0; probes < histogram.size(); probes++) {
+        count += histogram[probes];
+        sum += histogram[probes] * probes;
+    }
+    return count ? sum / double(count) : 0;
+}
+
+double ProbeStats::variance(const std::vector<uint64_t>& histogram) {
+    uint64_t count = total(histogram);
+    if (!count) return 0;
+    double mean = average(histogram), sum = 0;
+    for (unsigned int probes = 0; probes < histogram.size(); probes++) sum += histogram[probes] * (probes - mean) * (probes - mean);
+    return sum / count;
+}
+
+unsigned int ProbeStats::percentile(const std::vector<uint64_t>& histogram, double p) {
+    uint64_t count = total(histogram), seen = 0;
+    for (unsigned int probes = 0; probes < histogram.size(); probes++) {
+        seen += histogram[probes];
+        if (seen > 0 && seen >= p / 100 * count) return probes;
+    }
+    return 0;
+}
+
+void ProbeStats::output() const {
+    if (!enabled) {
+        std::cout << "-Probe Lengths: not tracked, build with -DHASH_TABLE_STATS" << std::endl;
+        return;
+    }
+    auto outputHistogram = [](const char* label, const std::vector<uint64_t>& histogram) {
+        std::cout << "-" << label << ": " << total(histogram);
+        if (total(histogram)) {
+            std::cout << "\tProbe Length p50: " << percentile(histogram, 50)
+                      << "\tp90: " << percentile(histogram, 90)
+                      << "\tp99: " << percentile(histogram, 99)
+                      << "\tMax: " << histogram.size() - 1
+                      << "\tAverage: " << average(histogram)
+                      << "\tVariance: " << variance(histogram);
+        }
+        std::cout << std::endl;
+    };
+    outputHistogram("Hits", hits);
+    outputHistogram("Misses", misses);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Probe-length histogram of insert/search/remove, separate for hits (key found) and misses (key absent).
+// Probe length counts the extra slots (nodes for chaining, groups for Swiss) looked at past the home one.
+// Collected only when compiled with -DHASH_TABLE_STATS, otherwise the record calls are empty and compile out.
+struct ProbeStats {
+#ifdef HASH_TABLE_STATS
+    static constexpr bool enabled = true;
+    std::vector<uint64_t> hits, misses; // hits[d] = operations that found their key after d extra probes
+
+    void recordHit(unsigned int probes) { record(hits, probes); }
+    void recordMiss(unsigned int probes) { record(misses, probes); }
+    void reset() { hits.clear(); misses.clear(); }
+    void merge(const ProbeStats& other) { // Add another table's counts, e.g. the shards of a ConcurrentHashTable
+        for (unsigned int probes = 0; probes < other.hits.size(); probes++) record(hits, probes, other.hits[probes]);
+        for (unsigned int probes = 0; probes < other.misses.size(); probes++) record(misses, probes, other.misses[probes]);
+    }
+    static void record(std::vector<uint64_t>& histogram, unsigned int probes, uint64_t times = 1) {
+        if (probes >= histogram.size()) histogram.resize(probes + 1);
+        histogram[probes] += times;
+    }
+#else
+    static constexpr bool enabled = false;
+    std::vector<uint64_t> hits, misses; // Always empty
+
+    void recordHit(unsigned int) {}
+    void recordMiss(unsigned int) {}
+    void reset() {}
+    void merge(const ProbeStats&) {}
+#endif
+
+    static uint64_t total(const std::vector<uint64_t>& histogram);
+    static double average(const std::vector<uint64_t>& histogram); // Mean probe length
+    static double variance(const std::vector<uint64_t>& histogram); // Spread of probe lengths around the mean
+    static unsigned int percentile(const std::vector<uint64_t>& histogram, double p); // Smallest length covering p% of operations
+    void output() const; // Percentiles of hits and misses
+};
@@ -0,0 +1,40 @@
+#include "Snapshot.hpp"
+
+bool openSnapshot(const MappedFile& file, const char* table, uint32_t keyBytes, uint32_t valueBytes, SnapshotView& view) {
+    if (!file.isOpen() || file.length < sizeof(SnapshotHeader)) return false;
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(file.begin());
+    if (std::memcmp(header->magic, "HTSNAP", 6) != 0 || header->version != SNAPSHOT_VERSION) return false;
+    if (std::strncmp(header->table, table, sizeof(header->table)) != 0 || header->keyBytes != keyBytes || header->valueBytes != valueBytes) return false;
+
+    // Walk the sections, checking each one and its padding fit in the file before it is used
+    size_t offset = 0, length = file.length;
+    auto section = [&](size_t bytes) -> const char* {
+        if (bytes > length - offset) return nullptr;
+        bytes += snapshotPadding(bytes);
+        if (bytes > length - offset) return nullptr;
+        const char* start = file.begin() + offset;
+        offset += bytes;
+        return start;
+    };
+    uint64_t size = header->size;
+    if (!size || (size & (size - 1)) || size > 0x80000000ULL) return false; // Table sizes are powers of 2 that fit an unsigned int
+    if (size > (length / (uint64_t(keyBytes) + 1))) return false; // Can't fit, also keeps the products below from overflowing
+    section(sizeof(SnapshotHeader));
+    view.header = header;
+    view.hashState = section(header->hashBytes);
+    view.keys = section(size * keyBytes);
+    view.states = reinterpret_cast<const uint8_t*>(section(size));
+    if (!view.hashState || !view.keys || !view.states) return false;
+    if (valueBytes) {
+        if (size > length / valueBytes) return false;
+        view.values = section(size * valueBytes);
+        return view.values != nullptr && offset == length; // Truncated or trailing bytes mean a damaged file
+    }
+    view.offsets = reinterpret_cast<const uint64_t*>(section((size + 1) * sizeof(uint64_t)));
+    if (!view.offsets || view.offsets[0] != 0) return false;
+    for (uint64_t i = 0; i < size; i++) {
+        if (view.offsets[i + 1] < view.offsets[i]) return false;
+    }
+    view.values = section(view.offsets[size]);
+    return view.values != nullptr && offset == length;
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <type_traits>
+#include "MappedFile.hpp"
+
+/*      -- Snapshots --
+Binary image of a built open addressing table, so a restart maps one file instead of parsing and rehashing the input text.
+    [SnapshotHeader][Hash policy state][keys: size * Key][slot states: size bytes][values]
+Slot states are the table's own occupancy/control bytes. Trivially copyable values are stored byte for byte,
+strings as text: [offsets: (size + 1) * uint64][characters], value i is characters[offsets[i], offsets[i + 1]).
+Every section starts 8-byte aligned. Loading with the same hash policy copies the sections straight into the table,
+any other policy reinserts the items.
+*/
+
+constexpr uint32_t SNAPSHOT_VERSION = 2; // Bump when the layout or the meaning of the slot states changes, files of other versions are rejected
+constexpr uint32_t SNAPSHOT_ROBIN_HOOD = 1; // Flag: slots are in Robin Hood order
+
+struct SnapshotHeader {
+    char magic[8]; // "HTSNAP"
+    uint32_t version;
+    uint32_t keyBytes; // sizeof(Key)
+    uint32_t valueBytes; // sizeof(Value) for values stored byte for byte, 0 for text
+    uint32_t hashBytes; // sizeof(Hash)
+    uint32_t flags; // SNAPSHOT_ROBIN_HOOD
+    uint32_t reserved;
+    char table[32]; // Table type, e.g. "Flat Linear"
+    char hash[32]; // Hash policy name()
+    uint64_t size, count, deleted; // Slots, items and tombstones
+};
+
+// Sections of a mapped snapshot, every pointer is into the file
+struct SnapshotView {
+    const SnapshotHeader* header = nullptr;
+    const char* hashState = nullptr;
+    const char* keys = nullptr;
+    const uint8_t* states = nullptr;
+    const char* values = nullptr; // Raw values, or the characters of the text values
+    const uint64_t* offsets = nullptr; // Text values only
+};
+
+template <typename Value> // String-like values (InlineString too, its spilled ones point into this process's arena) are stored as text
+constexpr bool rawSnapshotValue = std::is_trivially_copyable_v<Value> && !std::is_convertible_v<const Value&, std::string_view>;
+
+inline size_t snapshotPadding(size_t bytes) { return (8 - bytes % 8) % 8; }
+
+// Check the header and find the sections, false if the file is missing, truncated or written for another table or key/value type
+bool openSnapshot(const MappedFile& file, const char* table, uint32_t keyBytes, uint32_t valueBytes, SnapshotView& view);
+
+template <typename Key, typename Value>
+bool openSnapshot(const MappedFile& file, const char* table, SnapshotView& view) {
+    return openSnapshot(file, table, sizeof(Key), rawSnapshotValue<Value> ? sizeof(Value) : 0, view);
+}
+
+// Written with the same hash policy: the slot layout is valid as is once the policy's state is copied over
+template <typename Hash>
+bool sameHash(const SnapshotView& view, const Hash& hash) {
+    return std::strcmp(view.header->hash, hash.name()) == 0 && view.header->hashBytes == sizeof(Hash);
+}
+
+template <typename Hash>
+void loadHashState(const SnapshotView& view, Hash& hash) {
+    static_assert(std::is_trivially_copyable_v<Hash>, "Snapshots store the hash policy byte for byte");
+    std::memcpy(static_cast<void*>(&hash), view.hashState, sizeof(Hash));
+}
+
+template <typename Key>
+Key snapshotKey(const SnapshotView& view, uint64_t i) {
+    Key key;
+    std::memcpy(&key, view.keys + i * sizeof(Key), sizeof(Key));
+    return key;
+}
+
+template <typename Value>
+Value snapshotValue(const SnapshotView& view, uint64_t i) {
+    if constexpr (rawSnapshotValue<Value>) {
+        Value value;
+        std::memcpy(&value, view.values + i * sizeof(Value), sizeof(Value));
+        return value;
+    }
+    else return Value(std::string_view(view.values + view.offsets[i], view.offsets[i + 1] - view.offsets[i]));
+}
+
+// Every slot's value, one memcpy for raw values
+template <typename Value>
+void readSnapshotValues(const SnapshotView& view, std::vector<Value>& values) {
+    uint64_t size = view.header->size;
+    values = std::vector<Value>(size);
+    if constexpr (rawSnapshotValue<Value>) std::memcpy(static_cast<void*>(values.data()), view.values, size * sizeof(Value));
+    else {
+        for (uint64_t i = 0; i < size; i++) {
+            if (view.offsets[i + 1] > view.offsets[i]) values[i] = snapshotValue<Value>(view, i); // Empty slots keep Value()
+        }
+    }
+}
+
+// Write a snapshot of size slots, empty slots hold Key() and Value()
+template <typename Hash, typename Key, typename Value>
+bool writeSnapshot(const std::string& path, const char* table, const Hash& hash, uint32_t flags, uint64_t size, uint64_t count, uint64_t deleted,
+                   const Key* keys, const uint8_t* states, const Value* values) {
+    static_assert(std::is_trivially_copyable_v<Key>, "Snapshots store keys byte for byte");
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, "HTSNAP", 6);
+    header.version = SNAPSHOT_VERSION;
+    header.keyBytes = sizeof(Key);
+    header.valueBytes = rawSnapshotValue<Value> ? sizeof(Value) : 0;
+    header.hashBytes = sizeof(Hash);
+    header.flags = flags;
+    std::strncpy(header.table, table, sizeof(header.table) - 1);
+    std::strncpy(header.hash, hash.name(), sizeof(header.hash) - 1);
+    header.size = size;
+    header.count = count;
+    header.deleted = deleted;
+
+    auto writeSection = [&](const void* data, size_t bytes) {
+        static const char zeros[8] = {};
+        file.write(static_cast<const char*>(data), bytes);
+        file.write(zeros, snapshotPadding(bytes));
+    };
+    writeSection(&header, sizeof(header));
+    writeSection(&hash, sizeof(Hash));
+    writeSection(keys, size * sizeof(Key));
+    writeSection(states, size);
+    if constexpr (rawSnapshotValue<Value>) writeSection(values, size * sizeof(Value));
+    else {
+        std::vector<uint64_t> offsets(size + 1, 0);
+        std::string characters;
+        for (uint64_t i = 0; i < size; i++) {
+            std::string_view text(values[i]);
+            characters.append(text.data(), text.size());
+            offsets[i + 1] = characters.size();
+        }
+        writeSection(offsets.data(), offsets.size() * sizeof(uint64_t));
+        writeSection(characters.data(), characters.size());
+    }
+    return bool(file);
+}
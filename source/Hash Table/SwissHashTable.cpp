@@ -0,0 +1,4 @@
+#include "SwissHashTable.hpp"
+
+template struct SwissHashTable<FibonacciHash>;
+template struct SwissHashTable<ModuloHash>;
@@ -0,0 +1,363 @@
+#pragma once
+#include <cstdint>
+#include "HashTable.hpp"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_TABLE_SSE2
+#endif
+
+//          --Open addressing, group probing--
+// Swiss-table style: slots are split in groups of 16, each slot has a 1-byte control tag.
+// A lookup compares the tag against a whole group at once (SSE2, scalar fallback otherwise)
+// and only touches keys whose tag matched. Probing moves group by group (grow when load factor > 0.875 by default).
+template <typename Hash = ModuloHash, typename Key = unsigned int, typename Value = std::string>
+struct SwissHashTable {
+    using KeyType = Key;
+    using ValueType = Value;
+    using ValueViewType = ValueView<Value>; // search() result, a string_view into the table for string values
+    static constexpr unsigned int GROUP_WIDTH = 16;
+    static constexpr uint8_t EMPTY = 0x80; // Never used, ends every probe
+    static constexpr uint8_t DELETED = 0xFE; // Removed, probes continue past it
+    // Full slots hold a 7-bit tag (0x00 - 0x7F), so the top bit alone tells empty/deleted from full
+
+    Hash hash; // Hash policy, picks the home group
+    unsigned int size, groupPower, count = 0, deletedCount = 0; // size is the number of slots, groups = 2^groupPower
+    std::vector<uint8_t> control; // Control tag of each slot
+    std::vector<Key> keys; // UserIDs
+    std::vector<Value> values; // Passwords
+    ProbeStats stats; // Probe length histogram in groups, empty unless built with HASH_TABLE_STATS
+    LoadFactor load; // Grow and shrink limits, 0.875 and 0.109 unless set, tombstones count towards growing
+
+    SwissHashTable(unsigned int size, Hash hash = Hash());
+
+    void resetStats(); // Clear the probe length histogram
+    unsigned int hashFunction(Key key) const { return groupPower ? hash(key, groupPower) : 0; } // Home group from the Hash policy
+    double expectedProbes() const { double free = 1 - load.max; return (1 / (free * free) - 1) / 2 / GROUP_WIDTH; } // Linear probing's estimate, in groups instead of slots
+    uint8_t tagOf(Key key) const; // 7 Fibonacci product bits just below the ones a Fibonacci group index takes, for every policy
+    uint32_t matchTag(unsigned int group, uint8_t tag) const; // Bit i set if slot i of the group holds the tag
+    uint32_t matchEmpty(unsigned int group) const; // Bit i set if slot i of the group is EMPTY
+    uint32_t matchFree(unsigned int group) const; // Bit i set if slot i of the group is EMPTY or DELETED
+    void insert(Key key, Value value); // Insert if not found key or update value if found key
+    void remove(Key key); // Remove if found key or do nothing if not found
+    ValueViewType search(Key key) { return searchFrom(key, hashFunction(key)); } // Return value if found, empty if not found
+    ValueViewType searchFrom(Key key, unsigned int group); // search() from an already hashed home group
+    void searchBatch(const Key* keys, size_t n, ValueViewType* out); // out[i] = search(keys[i]), home groups of a batch are prefetched before probing
+    void insertBatch(const Key* keys, const Value* values, size_t n); // insert() each item, home groups of a batch are prefetched first
+    void resize(unsigned int newSize); // newSize is rounded up to a whole group
+    void reserve(unsigned int n); // Grow once so n items fit under the max load factor, removes won't shrink below that
+    void input(const std::string& path, unsigned int n); // Only read the first n lines from the file (memory mapped)
+    bool saveSnapshot(const std::string& path) const; // Write the slots to a binary snapshot, false if the file can't be written
+    bool loadSnapshot(const std::string& path); // Replace the contents with a snapshot, no rehashing if it was saved with the same hash policy
+    unsigned int displacement(unsigned int index) const { return (index / GROUP_WIDTH - hashFunction(keys[index])) & (size / GROUP_WIDTH - 1); } // Groups from the home group
+    unsigned int maxDisplacement() const;
+    size_t memoryBytes() const; // Bytes of the control, key and value arrays, not what the values allocate themselves
+    void outputStats(); // Output statistics of the hash table
+    void output(unsigned int n); // Output n items of the hash table
+};
+
+inline unsigned int lowestBit(uint32_t mask) { // Index of the lowest set bit, mask must not be 0
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    unsigned int bit = 0;
+    while (!(mask & 1)) mask >>= 1, bit++;
+    return bit;
+#endif
+}
+
+template <typename Hash, typename Key, typename Value>
+SwissHashTable<Hash, Key, Value>::SwissHashTable(unsigned int size, Hash hash) : hash(hash), size(std::max(size, GROUP_WIDTH)), groupPower(log2(this->size / GROUP_WIDTH)), control(this->size, EMPTY), keys(this->size), values(this->size), load(0.875, this->size, 0.95) {}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::resetStats() {
+    stats.reset();
+}
+
+template <typename Hash, typename Key, typename Value>
+uint8_t SwissHashTable<Hash, Key, Value>::tagOf(Key key) const {
+    // Taken under the bits a Fibonacci group index uses whatever the policy, an AdaptiveHash may be in Fibonacci mode.
+    // Under the other policies and modes any product bits filter as well.
+    if constexpr (sizeof(Key) <= 4) {
+        uint32_t product = uint32_t(key) * 2654435769U; // Same product as fibonacciHash
+        return (product >> (25 - std::min(groupPower, 25u))) & 0x7F;
+    }
+    else {
+        uint64_t product = foldKey(key) * 11400714819323198485ULL; // 64-bit product of fibonacciHash
+        return (product >> (57 - std::min(groupPower, 57u))) & 0x7F;
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+uint32_t SwissHashTable<Hash, Key, Value>::matchTag(unsigned int group, uint8_t tag) const {
+    const uint8_t* ctrl = &control[group * GROUP_WIDTH];
+#ifdef SWISS_TABLE_SSE2
+    __m128i slots = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(slots, _mm_set1_epi8(char(tag))));
+#else
+    uint32_t mask = 0;
+    for (unsigned int i = 0; i < GROUP_WIDTH; i++) mask |= uint32_t(ctrl[i] == tag) << i;
+    return mask;
+#endif
+}
+
+template <typename Hash, typename Key, typename Value>
+uint32_t SwissHashTable<Hash, Key, Value>::matchEmpty(unsigned int group) const {
+    return matchTag(group, EMPTY);
+}
+
+template <typename Hash, typename Key, typename Value>
+uint32_t SwissHashTable<Hash, Key, Value>::matchFree(unsigned int group) const {
+    const uint8_t* ctrl = &control[group * GROUP_WIDTH];
+#ifdef SWISS_TABLE_SSE2
+    return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))); // Top bit set means not full
+#else
+    uint32_t mask = 0;
+    for (unsigned int i = 0; i < GROUP_WIDTH; i++) mask |= uint32_t(ctrl[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::insert(Key key, Value value) {
+    if (load.grow(count + deletedCount)) resize(count > load.growAt / 2 ? size * 2 : size); // Grow, or only purge tombstones if they filled it up
+    else if (rehashDue(hash, size)) resize(size);
+
+    unsigned int groupMask = size / GROUP_WIDTH - 1;
+    unsigned int group = hashFunction(key);
+    unsigned int probes = 0; // Extra groups probed, for the stats
+    uint8_t tag = tagOf(key);
+    std::optional<unsigned int> freeSlot; // First empty or deleted slot on the probe sequence
+    while (true) {
+        for (uint32_t mask = matchTag(group, tag); mask; mask &= mask - 1) {
+            unsigned int index = group * GROUP_WIDTH + lowestBit(mask);
+            if (keys[index] == key) {
+                values[index] = std::move(value); // Update value if key already exists
+                stats.recordHit(probes);
+                return;
+            }
+        }
+        uint32_t freeMask = matchFree(group);
+        if (!freeSlot && freeMask) freeSlot = group * GROUP_WIDTH + lowestBit(freeMask);
+        if (matchEmpty(group)) break; // Key can't be in a later group
+        group = (group + 1) & groupMask; // Probe the next group
+        probes++;
+    }
+    stats.recordMiss(probes);
+    sampleProbes(hash, probes, *this);
+    unsigned int index = freeSlot.value();
+    if (control[index] == DELETED) deletedCount--;
+    control[index] = tag; // Insert new key-value pair
+    keys[index] = key;
+    values[index] = std::move(value);
+    count++;
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::remove(Key key) {
+    unsigned int groupMask = size / GROUP_WIDTH - 1;
+    unsigned int group = hashFunction(key);
+    unsigned int probes = 0; // Extra groups probed, for the stats
+    uint8_t tag = tagOf(key);
+    while (true) {
+        for (uint32_t mask = matchTag(group, tag); mask; mask &= mask - 1) {
+            unsigned int index = group * GROUP_WIDTH + lowestBit(mask);
+            if (keys[index] == key) { // Found
+                // A group with an empty slot never let a probe pass, so its slots can go straight back to EMPTY
+                if (matchEmpty(group)) control[index] = EMPTY;
+                else {
+                    control[index] = DELETED;
+                    deletedCount++;
+                }
+                values[index] = Value();
+                count--;
+                stats.recordHit(probes);
+                if (load.shrink(count, size)) resize(size / 2); // Halve once the load factor drops under the min limit
+                return;
+            }
+        }
+        if (matchEmpty(group)) { // Not found
+            stats.recordMiss(probes);
+            return;
+        }
+        group = (group + 1) & groupMask; // Probe the next group
+        probes++;
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+typename SwissHashTable<Hash, Key, Value>::ValueViewType SwissHashTable<Hash, Key, Value>::searchFrom(Key key, unsigned int group) {
+    unsigned int groupMask = size / GROUP_WIDTH - 1;
+    unsigned int probes = 0; // Extra groups probed, for the stats
+    uint8_t tag = tagOf(key);
+    while (true) {
+        for (uint32_t mask = matchTag(group, tag); mask; mask &= mask - 1) {
+            unsigned int index = group * GROUP_WIDTH + lowestBit(mask);
+            if (keys[index] == key) { // Found
+                stats.recordHit(probes);
+                return values[index];
+            }
+        }
+        if (matchEmpty(group)) { // Not found, most misses end in the home group
+            stats.recordMiss(probes);
+            return ValueViewType();
+        }
+        group = (group + 1) & groupMask; // Probe the next group
+        probes++;
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::searchBatch(const Key* searchKeys, size_t n, ValueViewType* out) {
+    unsigned int homes[BATCH_SIZE];
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) { // Hash the whole batch, the control bytes and keys of the home groups load in parallel
+            homes[i] = hashFunction(searchKeys[begin + i]);
+            prefetch(&control[homes[i] * GROUP_WIDTH]);
+            prefetch(&keys[homes[i] * GROUP_WIDTH]);
+        }
+        for (size_t i = 0; i < batch; i++) out[begin + i] = searchFrom(searchKeys[begin + i], homes[i]);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::insertBatch(const Key* newKeys, const Value* newValues, size_t n) {
+    for (size_t begin = 0; begin < n; begin += BATCH_SIZE) {
+        size_t batch = std::min<size_t>(BATCH_SIZE, n - begin);
+        for (size_t i = 0; i < batch; i++) {
+            unsigned int home = hashFunction(newKeys[begin + i]);
+            prefetch(&control[home * GROUP_WIDTH]);
+            prefetch(&keys[home * GROUP_WIDTH]);
+        }
+        for (size_t i = 0; i < batch; i++) insert(newKeys[begin + i], newValues[begin + i]); // Rehashes, a resize within the batch only wastes the prefetches
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::resize(unsigned int newSize) {
+    adaptHash(hash, size);
+    std::vector<uint8_t> oldControl = std::move(control);
+    std::vector<Key> oldKeys = std::move(keys);
+    std::vector<Value> oldValues = std::move(values);
+    size = std::max(newSize, GROUP_WIDTH);
+    groupPower = log2(size / GROUP_WIDTH);
+    load.update(size);
+    control.assign(size, EMPTY);
+    keys.assign(size, 0);
+    values = std::vector<Value>(size);
+    deletedCount = 0; // Tombstones are dropped by rehashing
+
+    unsigned int groupMask = size / GROUP_WIDTH - 1;
+    for (unsigned int i = 0; i < oldControl.size(); i++) {
+        if (oldControl[i] & 0x80) continue; // Empty or deleted
+        unsigned int group = hashFunction(oldKeys[i]);
+        uint32_t freeMask = matchFree(group);
+        while (!freeMask) {
+            group = (group + 1) & groupMask; // Probe the next group
+            freeMask = matchFree(group);
+        }
+        unsigned int index = group * GROUP_WIDTH + lowestBit(freeMask);
+        control[index] = tagOf(oldKeys[i]); // Reinsert the item, moving its value
+        keys[index] = oldKeys[i];
+        values[index] = std::move(oldValues[i]);
+    }
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::reserve(unsigned int n) {
+    load.reserve(n);
+    unsigned int newSize = load.fit(n, size);
+    if (newSize > size) resize(newSize);
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::input(const std::string& path, unsigned int n) {
+    bulkLoad(*this, path, n);
+}
+
+template <typename Hash, typename Key, typename Value>
+bool SwissHashTable<Hash, Key, Value>::saveSnapshot(const std::string& path) const {
+    return writeSnapshot(path, "Swiss", hash, 0, size, count, deletedCount, keys.data(), control.data(), values.data());
+}
+
+template <typename Hash, typename Key, typename Value>
+bool SwissHashTable<Hash, Key, Value>::loadSnapshot(const std::string& path) {
+    MappedFile file(path);
+    SnapshotView view;
+    if (!openSnapshot<Key, Value>(file, "Swiss", view)) return false;
+    const SnapshotHeader& header = *view.header;
+    if (header.size < GROUP_WIDTH || header.size % GROUP_WIDTH) return false;
+    uint64_t items = 0, deleted = 0, empty = 0; // The counts must match the control bytes, and a slot must be empty for probes to stop
+    for (uint64_t i = 0; i < header.size; i++) {
+        if (!(view.states[i] & 0x80)) items++;
+        else if (view.states[i] == DELETED) deleted++;
+        else if (view.states[i] == EMPTY) empty++;
+        else return false;
+    }
+    if (items != header.count || deleted != header.deleted || !empty) return false;
+    if (sameHash(view, hash)) { // Same layout, copy the control bytes, keys and values as they are
+        loadHashState(view, hash);
+        size = header.size;
+        groupPower = log2(size / GROUP_WIDTH);
+        load.update(size);
+        count = header.count;
+        deletedCount = header.deleted;
+        control.assign(view.states, view.states + size);
+        keys.resize(size);
+        std::memcpy(keys.data(), view.keys, size * sizeof(Key));
+        readSnapshotValues(view, values);
+        return true;
+    }
+    LoadFactor limits = load; // Limits set on this table outlive its contents
+    *this = SwissHashTable(header.size, hash); // Other hash policy, the items need new groups
+    load = limits;
+    load.update(size);
+    for (uint64_t i = 0; i < header.size; i++) {
+        if (!(view.states[i] & 0x80)) insert(snapshotKey<Key>(view, i), snapshotValue<Value>(view, i));
+    }
+    return true;
+}
+
+template <typename Hash, typename Key, typename Value>
+unsigned int SwissHashTable<Hash, Key, Value>::maxDisplacement() const {
+    unsigned int furthest = 0;
+    for (unsigned int i = 0; i < size; i++) {
+        if (!(control[i] & 0x80)) furthest = std::max(furthest, displacement(i));
+    }
+    return furthest;
+}
+
+template <typename Hash, typename Key, typename Value>
+size_t SwissHashTable<Hash, Key, Value>::memoryBytes() const {
+    return control.capacity() + keys.capacity() * sizeof(Key) + values.capacity() * sizeof(Value);
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::outputStats() {
+    std::cout << "\t\t---" << hash.name() << " Swiss Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+    std::cout << "\n-Max Displacement: " << maxDisplacement() << " groups" << std::endl;
+    outputHash(hash);
+    stats.output();
+}
+
+template <typename Hash, typename Key, typename Value>
+void SwissHashTable<Hash, Key, Value>::output(unsigned int n) {
+    std::cout << "\t\t---" << hash.name() << " Swiss Hash Table---\n"
+              << "\tSize: " << size << "\tNumber of items: " << count << "\tLoad Factor: " << count / float(size) << std::endl;
+
+    for (unsigned int i = 0; i < n; i++) {
+        std::cout << std::endl << i << ": ";
+        if (control[i] == EMPTY) std::cout << "null";
+        else if (control[i] == DELETED) std::cout << "deleted";
+        else {
+            std::cout << keys[i] << "|" << values[i];
+            if (displacement(i)) std::cout << "\n\tDisplacement: " << displacement(i) << " groups";
+        }
+    }
+    std::cout << "\n-Max Displacement: " << maxDisplacement() << " groups" << std::endl;
+    stats.output();
+}
+
+extern template struct SwissHashTable<FibonacciHash>;
+extern template struct SwissHashTable<ModuloHash>;
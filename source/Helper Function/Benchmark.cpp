@@ -0,0 +1,123 @@
+#include "Benchmark.hpp"
+#include <cmath>
+#include <iomanip>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+static int openCounter(uint64_t config) { // Counter of this thread on any CPU, user space only
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+PerfCounters::PerfCounters() {
+    cyclesFd = openCounter(PERF_COUNT_HW_CPU_CYCLES);
+    cacheMissesFd = openCounter(PERF_COUNT_HW_CACHE_MISSES);
+    available = cyclesFd >= 0 && cacheMissesFd >= 0;
+}
+
+PerfCounters::~PerfCounters() {
+    if (cyclesFd >= 0) close(cyclesFd);
+    if (cacheMissesFd >= 0) close(cacheMissesFd);
+}
+
+void PerfCounters::start() {
+    if (!available) return;
+    for (int fd : {cyclesFd, cacheMissesFd}) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void PerfCounters::stop(uint64_t& cycles, uint64_t& cacheMisses) {
+    cycles = cacheMisses = 0;
+    if (!available) return;
+    ioctl(cyclesFd, PERF_EVENT_IOC_DISABLE, 0);
+    ioctl(cacheMissesFd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(cyclesFd, &cycles, sizeof(cycles)) != sizeof(cycles)) cycles = 0;
+    if (read(cacheMissesFd, &cacheMisses, sizeof(cacheMisses)) != sizeof(cacheMisses)) cacheMisses = 0;
+}
+#else
+PerfCounters::PerfCounters() {}
+PerfCounters::~PerfCounters() {}
+void PerfCounters::start() {}
+void PerfCounters::stop(uint64_t& cycles, uint64_t& cacheMisses) { cycles = cacheMisses = 0; }
+#endif
+
+TrialStats summarize(std::vector<double> samples) {
+    TrialStats stats;
+    if (samples.empty()) return stats;
+    std::sort(samples.begin(), samples.end());
+    size_t middle = samples.size() / 2;
+    stats.median = samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+    stats.min = samples.front();
+    stats.max = samples.back();
+
+    double mean = 0, variance = 0;
+    for (double sample : samples) mean += sample;
+    mean /= samples.size();
+    for (double sample : samples) variance += (sample - mean) * (sample - mean);
+    if (samples.size() > 1) stats.stddev = std::sqrt(variance / (samples.size() - 1)); // Sample standard deviation
+    return stats;
+}
+
+uint64_t medianCount(std::vector<uint64_t> samples) {
+    if (samples.empty()) return 0;
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+void printBenchmark(const std::vector<BenchmarkResult>& results) {
+    std::cout << "\t\t---Benchmark---\n";
+    for (const BenchmarkResult& result : results) {
+        std::cout << result.table << " | " << result.hash << " | " << result.pattern << " | " << result.items << " items | "
+                  << "load " << result.minLoad << "-" << result.maxLoad << " | " << result.operation << ": " << result.time.median
+                  << " ms (+/- " << result.time.stddev << ") | " << result.opsPerSecond() / 1e6 << " Mops/s | " << result.bytesPerEntry << " B/entry";
+        if (result.cycles) std::cout << "\tCycles: " << result.cycles << "\tCache Misses: " << result.cacheMisses;
+        std::cout << "\n";
+    }
+}
+
+bool writeCSV(const std::string& path, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << "table,hash,pattern,items,operation,operations,trials,median_ms,stddev_ms,min_ms,max_ms,rss_mb,peak_rss_mb,cycles,cache_misses,max_load,min_load,ops_per_sec,bytes_per_entry\n";
+    file << std::setprecision(6);
+    for (const BenchmarkResult& result : results) {
+        file << result.table << ',' << result.hash << ',' << result.pattern << ',' << result.items << ','
+             << result.operation << ',' << result.operations << ',' << result.trials << ','
+             << result.time.median << ',' << result.time.stddev << ',' << result.time.min << ',' << result.time.max << ','
+             << result.rss << ',' << result.peakRss << ',' << result.cycles << ',' << result.cacheMisses << ','
+             << result.maxLoad << ',' << result.minLoad << ',' << result.opsPerSecond() << ',' << result.bytesPerEntry << '\n';
+    }
+    return bool(file);
+}
+
+bool writeJSON(const std::string& path, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << "[\n" << std::setprecision(6);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        file << "  {\"table\": \"" << result.table << "\", \"hash\": \"" << result.hash << "\", \"pattern\": \"" << result.pattern
+             << "\", \"items\": " << result.items << ", \"operation\": \"" << result.operation << "\", \"operations\": " << result.operations
+             << ", \"trials\": " << result.trials << ", \"median_ms\": " << result.time.median << ", \"stddev_ms\": " << result.time.stddev
+             << ", \"min_ms\": " << result.time.min << ", \"max_ms\": " << result.time.max << ", \"rss_mb\": " << result.rss
+             << ", \"peak_rss_mb\": " << result.peakRss << ", \"cycles\": " << result.cycles << ", \"cache_misses\": " << result.cacheMisses
+             << ", \"max_load\": " << result.maxLoad << ", \"min_load\": " << result.minLoad << ", \"ops_per_sec\": " << result.opsPerSecond()
+             << ", \"bytes_per_entry\": " << result.bytesPerEntry << "}"
+             << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    file << "]\n";
+    return bool(file);
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include "HelperFunction.hpp"
+#include "../Hash Table/LoadFactor.hpp"
+
+// Hardware counters of the calling thread through perf_event_open (Linux only).
+// If the kernel refuses them (other OS, perf_event_paranoid, VMs without a PMU) available stays false and they read 0.
+struct PerfCounters {
+    int cyclesFd = -1, cacheMissesFd = -1;
+    bool available = false;
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    void start(); // Reset and enable both counters
+    void stop(uint64_t& cycles, uint64_t& cacheMisses); // Disable and read both counters
+};
+
+struct TrialStats {
+    double median = 0, stddev = 0, min = 0, max = 0; // Milliseconds over the recorded trials
+};
+
+struct BenchmarkResult { // One row of the matrix
+    std::string table, hash, pattern, operation;
+    unsigned int items = 0, operations = 0, trials = 0; // Items read from the file, keys per operation phase
+    TrialStats time;
+    double rss = 0, peakRss = 0; // MB, sampled with the table of the last trial still alive
+    uint64_t cycles = 0, cacheMisses = 0; // Median over trials, 0 without hardware counters
+    double maxLoad = 0, minLoad = 0; // Load factor limits the table ran with
+    double bytesPerEntry = 0; // memoryBytes() / count after the phase, the cost side of the load factor trade
+
+    double opsPerSecond() const { return time.median > 0 ? operations / time.median * 1000 : 0; }
+};
+
+struct BenchmarkOptions {
+    unsigned int warmups = 1; // Untimed runs first, page in the input file and warm the allocator
+    unsigned int trials = 5; // Timed runs, each on a fresh table
+    bool hardwareCounters = false; // Read cycles and cache misses with perf_event_open
+    std::optional<double> maxLoad, minLoad; // Load factor limits, unset keeps the table's defaults
+};
+
+TrialStats summarize(std::vector<double> samples);
+uint64_t medianCount(std::vector<uint64_t> samples);
+void printBenchmark(const std::vector<BenchmarkResult>& results);
+bool writeCSV(const std::string& path, const std::vector<BenchmarkResult>& results);
+bool writeJSON(const std::string& path, const std::vector<BenchmarkResult>& results);
+
+// Time input/insert/search/remove the way testPerformance() does, over warmup and trial runs on fresh tables.
+// makeTable() returns each fresh table, built with the same options as the other tests. Adds one row per operation to results.
+template <typename HashTableType, typename MakeTable>
+void benchmarkTable(std::vector<BenchmarkResult>& results, const BenchmarkOptions& options, const std::string& tableName,
+                    const std::string& pattern, const std::string& inputFile, MakeTable makeTable, unsigned int n, unsigned int opSize) {
+    const char* operations[] = {"input", "insert", "search", "remove"};
+    std::vector<double> times[4];
+    std::vector<uint64_t> cycles[4], cacheMisses[4];
+    std::unique_ptr<PerfCounters> counters;
+    if (options.hardwareCounters) counters.reset(new PerfCounters());
+    std::vector<unsigned int> testKeys = generateRandomKeys(opSize);
+    std::string hashName;
+    ProcessMemory memory;
+    double maxLoad = 0, minLoad = 0, bytesPerEntry[4] = {};
+
+    for (unsigned int trial = 0; trial < options.warmups + options.trials; trial++) {
+        HashTableType hashTable = makeTable();
+        setLoadFactor(hashTable, options.maxLoad, options.minLoad);
+        hashName = hashTable.hash.name();
+        maxLoad = hashTable.load.max;
+        minLoad = hashTable.load.min;
+        auto phase = [&](unsigned int operation, auto body) {
+            uint64_t phaseCycles = 0, phaseCacheMisses = 0;
+            if (counters) counters->start();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto end = std::chrono::steady_clock::now();
+            if (counters) counters->stop(phaseCycles, phaseCacheMisses);
+            bytesPerEntry[operation] = hashTable.memoryBytes() / double(std::max(hashTable.count, 1u));
+            if (trial < options.warmups) return; // Warmup, not recorded
+            times[operation].push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            cycles[operation].push_back(phaseCycles);
+            cacheMisses[operation].push_back(phaseCacheMisses);
+        };
+
+        phase(0, [&]() { hashTable.input(inputFile, n); });
+        phase(1, [&]() { for (unsigned int key : testKeys) hashTable.insert(key, "Password123@"); });
+        phase(2, [&]() {
+            size_t hits = 0;
+            for (unsigned int key : testKeys) hits += !hashTable.search(key).empty();
+            benchmarkSink = hits;
+        });
+        phase(3, [&]() { for (unsigned int key : testKeys) hashTable.remove(key); });
+        memory = processMemory();
+    }
+
+    for (unsigned int operation = 0; operation < 4; operation++) {
+        BenchmarkResult result;
+        result.table = tableName;
+        result.hash = hashName;
+        result.pattern = pattern;
+        result.operation = operations[operation];
+        result.items = n;
+        result.operations = operation == 0 ? n : opSize;
+        result.trials = options.trials;
+        result.time = summarize(times[operation]);
+        result.rss = memory.rss;
+        result.peakRss = memory.peakRss;
+        result.cycles = medianCount(cycles[operation]);
+        result.cacheMisses = medianCount(cacheMisses[operation]);
+        result.maxLoad = maxLoad;
+        result.minLoad = minLoad;
+        result.bytesPerEntry = bytesPerEntry[operation];
+        results.push_back(result);
+    }
+}
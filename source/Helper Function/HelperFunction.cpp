@@ -1,37 +1,91 @@
-#include "HelperFunction.hpp"
-
-std::vector<unsigned int> generateRandomKeys(unsigned int n, unsigned int min, unsigned int max) {
-    std::vector<unsigned int> keys;
-    for (unsigned int i = 0; i < n; i++) {
-        keys.push_back(rand() % (max - min + 1) + min);
-    }
-    return keys;
-}
-
-std::vector<unsigned int> generateSequentialKeys(unsigned int n, unsigned int start) {
-    std::vector<unsigned int> keys;
-    for (unsigned int i = 0; i < n; i++) {
-        keys.push_back(start + i);
-    }
-    return keys;
-}
-
-std::vector<unsigned int> generateClusteredKeys(unsigned int n, unsigned int start, unsigned int clusterSize, unsigned int clusterGap) {
-    std::vector<unsigned int> keys;
-    keys.reserve(n);
-    unsigned int currentBase = start;
-
-    while (keys.size() < n) {
-        for (unsigned int i = 0; i < clusterSize && keys.size() < n; ++i) {
-            keys.push_back(currentBase + i);
-        }
-        currentBase += clusterGap;
-    }
-
-    return keys;
-}
-
-void printPerformance(float time, float memory) {
-    std::cout << "Execution Time: " << time << " ms\n";
-    std::cout << "Memory Usage: " << memory << " MB\n";
+#include "HelperFunction.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+volatile size_t benchmarkSink = 0;
+
+Xoshiro256& testRandom() {
+    thread_local Xoshiro256 random;
+    return random;
+}
+
+std::vector<unsigned int> generateRandomKeys(unsigned int n, unsigned int min, unsigned int max) {
+    std::vector<unsigned int> keys;
+    keys.reserve(n);
+    Xoshiro256& random = testRandom();
+    uint32_t range = max - min + 1; // 0 when the range is all 2^32 keys
+    for (unsigned int i = 0; i < n; i++) {
+        keys.push_back(range ? min + random.below(range) : uint32_t(random() >> 32));
+    }
+    return keys;
+}
+
+std::vector<unsigned int> generateSequentialKeys(unsigned int n, unsigned int start) {
+    std::vector<unsigned int> keys;
+    for (unsigned int i = 0; i < n; i++) {
+        keys.push_back(start + i);
+    }
+    return keys;
+}
+
+std::vector<unsigned int> generateClusteredKeys(unsigned int n, unsigned int start, unsigned int clusterSize, unsigned int clusterGap) {
+    std::vector<unsigned int> keys;
+    keys.reserve(n);
+    unsigned int currentBase = start;
+
+    while (keys.size() < n) {
+        for (unsigned int i = 0; i < clusterSize && keys.size() < n; ++i) {
+            keys.push_back(currentBase + i);
+        }
+        currentBase += clusterGap;
+    }
+
+    return keys;
+}
+
+void printPerformance(float time, float memory) {
+    std::cout << "Execution Time: " << time << " ms\n";
+    std::cout << "Memory Usage: " << memory << " MB\n";
+}
+
+void printLatency(std::vector<double>& latencies) {
+    if (latencies.empty()) return;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[std::min<size_t>(latencies.size() - 1, size_t(p / 100 * latencies.size()))]; };
+    std::cout << "Latency p50: " << percentile(50) << " ns"
+              << "\tp99: " << percentile(99) << " ns"
+              << "\tp99.9: " << percentile(99.9) << " ns"
+              << "\tMax: " << latencies.back() << " ns\n";
+}
+
+ProcessMemory processMemory() {
+    ProcessMemory memory;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        memory.rss = counters.WorkingSetSize / (1024.0 * 1024); // Convert bytes to MB
+        memory.peakRss = counters.PeakWorkingSetSize / (1024.0 * 1024);
+    }
+#else
+    std::ifstream status("/proc/self/status"); // Linux, sizes in kB
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) memory.rss = std::stod(line.substr(6)) / 1024; // Convert kB to MB
+        else if (line.compare(0, 6, "VmHWM:") == 0) memory.peakRss = std::stod(line.substr(6)) / 1024;
+    }
+    if (memory.peakRss == 0) { // No procfs, getrusage() only knows the peak
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        memory.peakRss = usage.ru_maxrss / (1024.0 * 1024); // Bytes on macOS
+#else
+        memory.peakRss = usage.ru_maxrss / 1024.0; // kB
+#endif
+    }
+#endif
+    return memory;
 }
\ No newline at end of file
@@ -1,126 +1,377 @@
-#pragma once
-#include <cstdlib>
-#include <iostream>
-#include <vector>
-#include <chrono>
-#include <utility>
-#include <windows.h> 
-#include <Psapi.h>
-
-std::vector<unsigned int> generateRandomKeys(unsigned int n, unsigned int min = 99999999, unsigned int max = 999999999);
-std::vector<unsigned int> generateSequentialKeys(unsigned int n, unsigned int start = 100000000);
-std::vector<unsigned int> generateClusteredKeys(unsigned int n, unsigned int start = 100000000);
-void printPerformance(float time, float memory);
-
-template <typename Func, typename... Args>
-std::pair<double, double> measureExecutionTime(Func func, Args&&... args) { // pair of <Time, Memory>
-    PROCESS_MEMORY_COUNTERS memBefore{}, memAfter{};
-    auto start = std::chrono::high_resolution_clock::now();
-    GetProcessMemoryInfo(GetCurrentProcess(), &memBefore, sizeof(memBefore));
-
-    func(std::forward<Args>(args)...);
-    GetProcessMemoryInfo(GetCurrentProcess(), &memAfter, sizeof(memAfter));
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-
-    return {
-        duration.count() / 1000.0, // Convert microseconds to milliseconds
-        static_cast<double>(memAfter.PeakWorkingSetSize - memBefore.PeakWorkingSetSize) / (1024 * 1024) // Convert bytes to MB
-    };
-}
-
-// Debug hash table contents and the performance function
-template <typename HashTableType>
-void debugHashTable(const std::string& inputFile, HashTableType& hashTable, unsigned int n, unsigned int opSize) { // !LOW N VALUE!
-    std::vector<unsigned int> testKeys;
-    std::pair<double, double> timeMemory;
-    
-    if (inputFile.find("Cluster") != std::string::npos) testKeys = generateClusteredKeys(opSize);
-    else if (inputFile.find("Sequential") != std::string::npos) testKeys = generateSequentialKeys(opSize);
-    else testKeys = generateRandomKeys(opSize);
-
-    std::cout << "Debugging with " << n << " items from " << inputFile << "\n";
-
-    std::cout << "\n\tInputing " << n << " items...\n";
-    timeMemory = measureExecutionTime([&]() {
-        hashTable.input(inputFile, n);
-    });
-    hashTable.output(hashTable.size);
-    printPerformance(timeMemory.first, timeMemory.second);
-    hashTable.resetCollisions();
-
-    std::cout << "\n\tAdding " << opSize << " items...\n";
-    timeMemory = measureExecutionTime([&]() {
-        for (unsigned int key : testKeys) {
-            hashTable.insert(key, "Password123@");
-        }
-    });
-    hashTable.output(hashTable.size);
-    printPerformance(timeMemory.first, timeMemory.second);
-    hashTable.resetCollisions();
-
-    std::cout << "\n\tSearching " << opSize << " items...\n";
-    timeMemory = measureExecutionTime([&]() {
-        for (unsigned int key : testKeys) {
-            hashTable.search(key);
-        }
-    });
-    hashTable.output(hashTable.size);
-    printPerformance(timeMemory.first, timeMemory.second);
-    hashTable.resetCollisions();
-
-    std::cout << "\n\tRemoving " << opSize << " items...\n";
-    timeMemory = measureExecutionTime([&]() {
-        for (unsigned int key : testKeys) {
-            hashTable.remove(key);
-        }
-    });
-    hashTable.output(hashTable.size);
-    printPerformance(timeMemory.first, timeMemory.second);
-}
-
-// Print statistics and performance of the hash table
-template <typename HashTableType>
-void testPerformance(const std::string& inputFile, HashTableType& hashTable, unsigned int n, unsigned int opSize) {
-    std::vector<unsigned int> testKeys = generateRandomKeys(opSize);
-    std::pair<double, double> timeMemory;
-
-    std::cout << "Testing performance with " << n << " items from " << inputFile << "\n";
-
-    std::cout << "\n\tInputing " << n << " items...\n";
-    timeMemory = measureExecutionTime([&]() {
-        hashTable.input(inputFile, n);
-    });    
-    hashTable.outputStats();
-    printPerformance(timeMemory.first, timeMemory.second);
-    hashTable.resetCollisions();
-
-    std::cout << "\n\tAdding " << opSize << " items...\n";
-    timeMemory = measureExecutionTime([&]() {
-        for (unsigned int key : testKeys) {
-            hashTable.insert(key, "Password123@");
-        }
-    });
-    hashTable.outputStats();
-    printPerformance(timeMemory.first, timeMemory.second);
-    hashTable.resetCollisions();
-
-    std::cout << "\n\tSearching " << opSize << " items...\n";
-    timeMemory = measureExecutionTime([&]() {
-        for (unsigned int key : testKeys) {
-            hashTable.search(key);
-        }
-    });
-    hashTable.outputStats();
-    printPerformance(timeMemory.first, timeMemory.second);
-    hashTable.resetCollisions();
-
-    std::cout << "\n\tRemoving " << opSize << " items...\n";
-    timeMemory = measureExecutionTime([&]() {
-        for (unsigned int key : testKeys) {
-            hashTable.remove(key);
-        }
-    });
-    hashTable.outputStats();
-    printPerformance(timeMemory.first, timeMemory.second);
+#pragma once
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <utility>
+#include <unordered_set>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include <random>
+#include "../Hash Table/ProbeStats.hpp"
+#include "Random.hpp"
+
+struct ProcessMemory {
+    double rss = 0; // Resident set size now, in MB
+    double peakRss = 0; // Highest resident set size so far, in MB
+};
+
+Xoshiro256& testRandom(); // Generator behind the test helpers' random keys, one per thread, reseed it to repeat a run
+std::vector<unsigned int> generateRandomKeys(unsigned int n, unsigned int min = 99999999, unsigned int max = 999999999);
+std::vector<unsigned int> generateSequentialKeys(unsigned int n, unsigned int start = 100000000);
+std::vector<unsigned int> generateClusteredKeys(unsigned int n, unsigned int start = 100000000, unsigned int clusterSize = 100, unsigned int clusterGap = 1000);
+void printPerformance(float time, float memory);
+void printLatency(std::vector<double>& latencies); // Percentiles of per-operation latencies in nanoseconds (sorts the vector)
+ProcessMemory processMemory(); // PSAPI on Windows, /proc/self/status on Linux, getrusage() peak elsewhere
+extern volatile size_t benchmarkSink; // Timed loops store their results here, so the compiler can't drop the work
+
+template <typename Func, typename... Args>
+std::pair<double, double> measureExecutionTime(Func func, Args&&... args) { // pair of <Time, Memory>
+    ProcessMemory memBefore = processMemory();
+    auto start = std::chrono::steady_clock::now();
+
+    func(std::forward<Args>(args)...);
+    auto end = std::chrono::steady_clock::now();
+    ProcessMemory memAfter = processMemory();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    return {
+        duration.count() / 1000.0, // Convert microseconds to milliseconds
+        memAfter.peakRss - memBefore.peakRss // Growth of the peak, in MB
+    };
+}
+
+// Debug hash table contents and the performance function
+template <typename HashTableType>
+void debugHashTable(const std::string& inputFile, HashTableType& hashTable, unsigned int n, unsigned int opSize) { // !LOW N VALUE!
+    std::vector<unsigned int> testKeys;
+    std::pair<double, double> timeMemory;
+    
+    if (inputFile.find("Cluster") != std::string::npos) testKeys = generateClusteredKeys(opSize);
+    else if (inputFile.find("Sequential") != std::string::npos) testKeys = generateSequentialKeys(opSize);
+    else testKeys = generateRandomKeys(opSize);
+
+    std::cout << "Debugging with " << n << " items from " << inputFile << "\n";
+
+    std::cout << "\n\tInputing " << n << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        hashTable.input(inputFile, n);
+    });
+    hashTable.output(hashTable.size);
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    std::cout << "\n\tAdding " << opSize << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        for (unsigned int key : testKeys) {
+            hashTable.insert(key, "Password123@");
+        }
+    });
+    hashTable.output(hashTable.size);
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    std::cout << "\n\tSearching " << opSize << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        for (unsigned int key : testKeys) {
+            hashTable.search(key);
+        }
+    });
+    hashTable.output(hashTable.size);
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    std::cout << "\n\tRemoving " << opSize << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        for (unsigned int key : testKeys) {
+            hashTable.remove(key);
+        }
+    });
+    hashTable.output(hashTable.size);
+    printPerformance(timeMemory.first, timeMemory.second);
+}
+
+// Print statistics and performance of the hash table
+template <typename HashTableType>
+void testPerformance(const std::string& inputFile, HashTableType& hashTable, unsigned int n, unsigned int opSize) {
+    std::vector<unsigned int> testKeys = generateRandomKeys(opSize);
+    std::pair<double, double> timeMemory;
+
+    std::cout << "Testing performance with " << n << " items from " << inputFile << "\n";
+
+    std::cout << "\n\tInputing " << n << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        hashTable.input(inputFile, n);
+    });    
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    std::cout << "\n\tAdding " << opSize << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        for (unsigned int key : testKeys) {
+            hashTable.insert(key, "Password123@");
+        }
+    });
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    std::cout << "\n\tSearching " << opSize << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        size_t hits = 0;
+        for (unsigned int key : testKeys) {
+            hits += !hashTable.search(key).empty();
+        }
+        benchmarkSink = hits;
+    });
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    // Same keys through searchBatch(), home slots are prefetched BATCH_SIZE keys at a time so their cache misses overlap
+    std::vector<typename HashTableType::ValueViewType> results(opSize);
+    std::cout << "\n\tSearching " << opSize << " items in batches...\n";
+    timeMemory = measureExecutionTime([&]() {
+        hashTable.searchBatch(testKeys.data(), testKeys.size(), results.data());
+        size_t hits = 0;
+        for (const auto& result : results) hits += !result.empty();
+        benchmarkSink = hits;
+    });
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    std::cout << "\n\tRemoving " << opSize << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        for (unsigned int key : testKeys) {
+            hashTable.remove(key);
+        }
+    });
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    // Add the removed keys back through insertBatch(), comparable to the per-key adds above
+    std::vector<typename HashTableType::ValueType> values(opSize, "Password123@");
+    std::cout << "\n\tAdding " << opSize << " items in batches...\n";
+    timeMemory = measureExecutionTime([&]() {
+        hashTable.insertBatch(testKeys.data(), values.data(), testKeys.size());
+    });
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+}
+
+// Search keys that were never inserted (unknown IDs), the longest probes for open addressing
+template <typename HashTableType>
+void testMisses(const std::string& inputFile, HashTableType& hashTable, unsigned int n, unsigned int opSize) {
+    std::vector<unsigned int> missingKeys = generateRandomKeys(opSize, 1000000000, 4000000000); // Input keys have at most 9 digits
+    std::pair<double, double> timeMemory;
+
+    std::cout << "Testing misses with " << n << " items from " << inputFile << "\n";
+
+    std::cout << "\n\tInputing " << n << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        hashTable.input(inputFile, n);
+    });
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    std::cout << "\n\tSearching " << opSize << " missing items...\n";
+    unsigned int found = 0;
+    timeMemory = measureExecutionTime([&]() {
+        for (unsigned int key : missingKeys) {
+            if (!hashTable.search(key).empty()) found++;
+        }
+    });
+    hashTable.outputStats();
+    std::cout << "-Unexpected Hits: " << found << std::endl;
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+}
+
+// Churn removes and inserts opSize keys per round, then searches every live key to check probe length stays flat (needs HASH_TABLE_STATS)
+template <typename HashTableType>
+void testChurn(HashTableType& hashTable, unsigned int n, unsigned int opSize, unsigned int rounds) {
+    std::vector<unsigned int> liveKeys;
+    std::unordered_set<unsigned int> present;
+    std::pair<double, double> timeMemory;
+    auto addKeys = [&](unsigned int amount) {
+        for (unsigned int key : generateRandomKeys(amount)) {
+            if (!present.insert(key).second) continue; // Skip duplicates so every live key is stored once
+            hashTable.insert(key, "Password123@");
+            liveKeys.push_back(key);
+        }
+    };
+
+    std::cout << "Testing churn with " << n << " items, " << rounds << " rounds of " << opSize << " removes and inserts\n";
+    addKeys(n);
+    std::vector<unsigned int> removedKeys;
+    for (unsigned int round = 1; round <= rounds; round++) {
+        removedKeys.clear();
+        for (unsigned int i = 0; i < opSize && !liveKeys.empty(); i++) {
+            unsigned int pick = testRandom().below(liveKeys.size());
+            hashTable.remove(liveKeys[pick]);
+            present.erase(liveKeys[pick]);
+            removedKeys.push_back(liveKeys[pick]);
+            liveKeys[pick] = liveKeys.back();
+            liveKeys.pop_back();
+        }
+        // Half of the inserts bring removed keys back into the chains the removes just rearranged, the rest are new keys
+        unsigned int returning = removedKeys.size() / 2;
+        for (unsigned int i = 0; i < returning; i++) {
+            hashTable.insert(removedKeys[i], "Password123@");
+            present.insert(removedKeys[i]);
+            liveKeys.push_back(removedKeys[i]);
+        }
+        addKeys(opSize - returning);
+        hashTable.resetStats();
+
+        unsigned int lostKeys = 0;
+        timeMemory = measureExecutionTime([&]() {
+            for (unsigned int key : liveKeys) {
+                if (hashTable.search(key).empty()) lostKeys++;
+            }
+        });
+        std::cout << "\n\tRound " << round << ": " << liveKeys.size() << " live items";
+        if (ProbeStats::enabled) { // Probe length counts the home slot too
+            std::cout << "\n-Average Probe Length: " << 1 + ProbeStats::average(hashTable.stats.hits)
+                      << "\tp99: " << 1 + ProbeStats::percentile(hashTable.stats.hits, 99);
+        }
+        std::cout << "\n-Lost Keys: " << lostKeys << std::endl;
+        printPerformance(timeMemory.first, timeMemory.second);
+    }
+    hashTable.resetStats();
+}
+
+// Time every operation on its own to expose tail latency (resize spikes), reported as percentiles
+template <typename HashTableType>
+void testLatency(const std::string& inputFile, HashTableType& hashTable, unsigned int n, unsigned int opSize) {
+    std::vector<unsigned int> testKeys = generateRandomKeys(opSize);
+    std::vector<double> latencies;
+    latencies.reserve(std::max(n, opSize));
+    auto timeOperation = [&](auto operation) {
+        auto start = std::chrono::steady_clock::now();
+        operation();
+        auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    };
+
+    std::cout << "Testing latency with " << n << " items from " << inputFile << "\n";
+
+    std::cout << "\n\tInputing " << n << " items...\n";
+    std::ifstream file(inputFile);
+    unsigned int key;
+    std::string value;
+    for (unsigned int i = 0; i < n && file >> key >> value; i++) timeOperation([&]() { hashTable.insert(key, value); });
+    printLatency(latencies);
+
+    std::cout << "\n\tAdding " << opSize << " items...\n";
+    latencies.clear();
+    for (unsigned int testKey : testKeys) timeOperation([&]() { hashTable.insert(testKey, "Password123@"); });
+    printLatency(latencies);
+
+    std::cout << "\n\tSearching " << opSize << " items...\n";
+    latencies.clear();
+    for (unsigned int testKey : testKeys) timeOperation([&]() { hashTable.search(testKey); });
+    printLatency(latencies);
+
+    std::cout << "\n\tRemoving " << opSize << " items...\n";
+    latencies.clear();
+    for (unsigned int testKey : testKeys) timeOperation([&]() { hashTable.remove(testKey); });
+    printLatency(latencies);
+    hashTable.resetStats();
+}
+
+// Build a fresh table from the input file with 1, 2, 4 and 8 threads to show how the parallel build scales
+template <typename HashTableType>
+void testParallelBuild(const std::string& inputFile, unsigned int initialSize, unsigned int n) {
+    std::pair<double, double> timeMemory;
+
+    std::cout << "Testing parallel build with " << n << " items from " << inputFile << "\n";
+    for (unsigned int threadCount : {1u, 2u, 4u, 8u}) {
+        HashTableType hashTable(initialSize);
+        std::cout << "\n\tInputing " << n << " items on " << threadCount << " thread(s)...\n";
+        timeMemory = measureExecutionTime([&]() {
+            hashTable.parallelInput(inputFile, n, threadCount);
+        });
+        hashTable.outputStats();
+        printPerformance(timeMemory.first, timeMemory.second);
+    }
+}
+
+// Build from the text file, save a binary snapshot and load it back into the table, loading skips parsing and rehashing
+template <typename HashTableType>
+void testSnapshot(const std::string& inputFile, HashTableType& hashTable, unsigned int n, const std::string& snapshotFile) {
+    std::pair<double, double> timeMemory;
+    bool succeeded = false;
+
+    std::cout << "Testing snapshots with " << n << " items from " << inputFile << "\n";
+
+    std::cout << "\n\tInputing " << n << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        hashTable.input(inputFile, n);
+    });
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+    unsigned int count = hashTable.count;
+
+    std::cout << "\n\tSaving snapshot to " << snapshotFile << "...\n";
+    timeMemory = measureExecutionTime([&]() {
+        succeeded = hashTable.saveSnapshot(snapshotFile);
+    });
+    if (!succeeded) {
+        std::cout << "Could not write " << snapshotFile << std::endl;
+        return;
+    }
+    printPerformance(timeMemory.first, timeMemory.second);
+
+    std::cout << "\n\tLoading snapshot from " << snapshotFile << "...\n";
+    timeMemory = measureExecutionTime([&]() {
+        succeeded = hashTable.loadSnapshot(snapshotFile);
+    });
+    if (!succeeded) {
+        std::cout << "Could not read " << snapshotFile << std::endl;
+        return;
+    }
+    hashTable.outputStats();
+    std::cout << "-Items Restored: " << hashTable.count << " of " << count << std::endl;
+    printPerformance(timeMemory.first, timeMemory.second);
+}
+
+// Mixed 90% search / 5% insert / 5% remove workload on 1, 2, 4 and 8 threads sharing one table, reports throughput
+template <typename ConcurrentHashTableType>
+void testConcurrency(const std::string& inputFile, unsigned int initialSize, unsigned int n, unsigned int opSize) {
+    std::vector<unsigned int> testKeys = generateRandomKeys(opSize);
+
+    std::cout << "Testing concurrency with " << n << " items from " << inputFile << "\n";
+    for (unsigned int threadCount : {1u, 2u, 4u, 8u}) {
+        ConcurrentHashTableType hashTable(initialSize);
+        hashTable.input(inputFile, n);
+        for (unsigned int i = 0; i < testKeys.size(); i += 2) hashTable.insert(testKeys[i], "Password123@"); // Half of the searches hit
+
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int t = 0; t < threadCount; t++) {
+            threads.emplace_back([&, t]() {
+                Xoshiro256 random(t + 1); // Per thread, its own stream
+                for (unsigned int i = 0; i < opSize; i++) {
+                    unsigned int key = testKeys[random.below(testKeys.size())], operation = random.below(100);
+                    if (operation < 90) hashTable.search(key);
+                    else if (operation < 95) hashTable.insert(key, "Password123@");
+                    else hashTable.remove(key);
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        auto end = std::chrono::steady_clock::now();
+        double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << "\n\t" << threadCount << " thread(s), " << opSize << " operations each\n";
+        std::cout << "Execution Time: " << milliseconds << " ms\n";
+        std::cout << "Throughput: " << threadCount * opSize / milliseconds / 1000 << " million operations/s\n";
+    }
 }
\ No newline at end of file
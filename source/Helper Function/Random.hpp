@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+// xoshiro256** (Blackman and Vigna): 256 bits of state, a few shifts, rotates and one multiply per number.
+// Seeded through splitmix64, so nearby seeds still give unrelated streams. Meets UniformRandomBitGenerator,
+// so it also drives std::shuffle and the <random> distributions.
+struct Xoshiro256 {
+    using result_type = uint64_t;
+    uint64_t state[4];
+
+    explicit Xoshiro256(uint64_t seed = 3) {
+        for (uint64_t& word : state) { // splitmix64
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t mixed = seed;
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+            word = mixed ^ (mixed >> 31);
+        }
+    }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+    static uint64_t rotate(uint64_t x, int bits) { return (x << bits) | (x >> (64 - bits)); }
+
+    uint64_t operator()() {
+        uint64_t result = rotate(state[1] * 5, 7) * 9;
+        uint64_t shifted = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotate(state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, bound) without modulo bias: Lemire's multiply-shift, redrawing only in the sliver that would be biased
+    uint32_t below(uint32_t bound) {
+        uint64_t product = ((*this)() >> 32) * bound;
+        if (uint32_t(product) < bound) {
+            uint32_t threshold = uint32_t(-bound) % bound;
+            while (uint32_t(product) < threshold) product = ((*this)() >> 32) * bound;
+        }
+        return uint32_t(product >> 32);
+    }
+
+    double unit() { return ((*this)() >> 11) * 0x1.0p-53; } // Uniform in [0, 1), 53 random bits
+};
@@ -0,0 +1,227 @@
+#include "Scenario.hpp"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+
+static std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n"), end = text.find_last_not_of(" \t\r\n");
+    return begin == std::string::npos ? "" : text.substr(begin, end - begin + 1);
+}
+
+static bool parseUnsigned(const std::string& text, unsigned int& value) {
+    if (text.empty() || text.size() > 9 || !std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; })) return false;
+    value = std::stoul(text);
+    return true;
+}
+
+static bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    double number = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end || !(number >= 0 && number <= 1000)) return false; // Also rejects nan
+    value = number;
+    return true;
+}
+
+static bool parseLoad(const std::string& text, std::optional<double>& value) {
+    double number;
+    if (!parseDouble(text, number)) return false;
+    value = number;
+    return true;
+}
+
+static bool parsePercents(const std::string& text, std::initializer_list<unsigned int*> values, bool addUp) { // "a/b/..." with one part per value
+    size_t begin = 0, total = 0, part = 0;
+    for (unsigned int* value : values) {
+        size_t end = ++part < values.size() ? text.find('/', begin) : text.size();
+        if (end == std::string::npos || !parseUnsigned(text.substr(begin, end - begin), *value) || *value > 100) return false;
+        total += *value;
+        begin = end + 1;
+    }
+    return !addUp || total == 100;
+}
+
+static bool parseBool(const std::string& text, bool& value) {
+    if (text == "true" || text == "1" || text == "yes" || text == "on") value = true;
+    else if (text == "false" || text == "0" || text == "no" || text == "off") value = false;
+    else return false;
+    return true;
+}
+
+static bool oneOf(const std::string& text, std::initializer_list<const char*> choices) {
+    for (const char* choice : choices) if (text == choice) return true;
+    return false;
+}
+
+std::string Scenario::pattern() const {
+    size_t begin = input.find_last_of("/\\");
+    begin = begin == std::string::npos ? 0 : begin + 1;
+    size_t end = input.find('.', begin);
+    return input.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+}
+
+bool setOption(Scenario& scenario, const std::string& key, const std::string& value, std::string& error) {
+    bool valid = true;
+    if (key == "name") scenario.name = value;
+    else if (key == "input") scenario.input = value;
+    else if (key == "table") valid = oneOf(value, {"linear", "flat", "swiss", "chain", "bucket", "all"}) && (scenario.table = value, true);
+    else if (key == "hash") valid = oneOf(value, {"fibonacci", "modulo", "multiply-shift", "murmur", "adaptive"}) && (scenario.hash = value, true);
+    else if (key == "test") valid = oneOf(value, {"performance", "debug", "misses", "churn", "latency", "parallel", "concurrency", "snapshot", "benchmark", "workload"}) && (scenario.test = value, true);
+    else if (key == "size") {
+        valid = parseUnsigned(value, scenario.initialSize) && scenario.initialSize >= MIN_TABLE_SIZE && !(scenario.initialSize & (scenario.initialSize - 1));
+        if (!valid) {
+            error = "invalid value '" + value + "' for 'size', expected a power of 2 of at least " + std::to_string(MIN_TABLE_SIZE);
+            return false;
+        }
+    }
+    else if (key == "lines") valid = parseUnsigned(value, scenario.lines);
+    else if (key == "operations") valid = parseUnsigned(value, scenario.operations);
+    else if (key == "seed") valid = parseUnsigned(value, scenario.seed);
+    else if (key == "incremental") valid = parseBool(value, scenario.incremental);
+    else if (key == "tombstones") valid = parseBool(value, scenario.tombstones);
+    else if (key == "probing") valid = oneOf(value, {"linear", "robin-hood"}) && (scenario.probing = value, true);
+    else if (key == "values") valid = oneOf(value, {"string", "inline"}) && (scenario.values = value, true);
+    else if (key == "rounds") valid = parseUnsigned(value, scenario.rounds);
+    else if (key == "snapshot") scenario.snapshot = value;
+    else if (key == "warmups") valid = parseUnsigned(value, scenario.warmups);
+    else if (key == "trials") valid = parseUnsigned(value, scenario.trials) && scenario.trials;
+    else if (key == "counters") valid = parseBool(value, scenario.counters);
+    else if (key == "max-load") valid = parseLoad(value, scenario.maxLoad) && scenario.maxLoad.value() > 0;
+    else if (key == "min-load") valid = parseLoad(value, scenario.minLoad);
+    else if (key == "mix") valid = parsePercents(value, {&scenario.readPercent, &scenario.insertPercent, &scenario.removePercent}, true);
+    else if (key == "distribution") valid = oneOf(value, {"uniform", "zipf", "hotspot"}) && (scenario.distribution = value, true);
+    else if (key == "skew") valid = parseDouble(value, scenario.skew) && scenario.skew > 0;
+    else if (key == "hotspot") valid = parsePercents(value, {&scenario.hotKeyPercent, &scenario.hotAccessPercent}, false);
+    else if (key == "hits") valid = parseUnsigned(value, scenario.hitPercent) && scenario.hitPercent <= 100;
+    else if (key == "record") scenario.record = value;
+    else if (key == "replay") scenario.replay = value;
+    else {
+        error = "unknown setting '" + key + "'";
+        return false;
+    }
+    if (!valid) error = "invalid value '" + value + "' for '" + key + "'";
+    return valid;
+}
+
+bool parseArguments(int argc, char** argv, Settings& settings, std::string& scenarioFile, std::string& output, std::string& error) {
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i], key, value;
+        if (argument.compare(0, 2, "--") != 0) {
+            error = "unexpected argument '" + argument + "'";
+            return false;
+        }
+        size_t equals = argument.find('=');
+        if (equals != std::string::npos) { // --key=value
+            key = argument.substr(2, equals - 2);
+            value = argument.substr(equals + 1);
+        }
+        else { // --key value, or a bare --flag meaning true
+            key = argument.substr(2);
+            if (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0) value = argv[++i];
+            else value = "true";
+        }
+
+        if (key == "scenario") scenarioFile = value;
+        else if (key == "output") output = value;
+        else {
+            Scenario check; // Reject bad flags up front, lists are checked item by item when expanded
+            std::string item = trim(value.substr(0, value.find(',')));
+            if (!setOption(check, key, item, error)) return false;
+            settings.emplace_back(key, value);
+        }
+    }
+    return true;
+}
+
+bool expandScenarios(const std::string& name, const Settings& settings, std::vector<Scenario>& scenarios, std::string& error) {
+    for (size_t i = 0; i < settings.size(); i++) {
+        const std::string& value = settings[i].second;
+        if (value.find(',') == std::string::npos) continue;
+        size_t begin = 0; // Expand the first list, the recursion handles the rest
+        while (begin <= value.size()) {
+            size_t end = std::min(value.find(',', begin), value.size());
+            Settings expanded = settings;
+            expanded[i].second = trim(value.substr(begin, end - begin));
+            if (!expandScenarios(name, expanded, scenarios, error)) return false;
+            begin = end + 1;
+        }
+        return true;
+    }
+
+    Scenario scenario;
+    scenario.name = name;
+    for (const auto& [key, value] : settings) {
+        if (!setOption(scenario, key, trim(value), error)) {
+            error = name + ": " + error;
+            return false;
+        }
+    }
+    scenarios.push_back(scenario);
+    return true;
+}
+
+bool loadScenarios(const std::string& path, const Settings& overrides, std::vector<Scenario>& scenarios, std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "cannot open scenario file '" + path + "'";
+        return false;
+    }
+    Settings global;
+    std::vector<std::pair<std::string, Settings>> sections;
+    std::string line;
+    for (unsigned int lineNumber = 1; std::getline(file, line); lineNumber++) {
+        line = trim(line.substr(0, line.find_first_of(";#"))); // Strip comments
+        if (line.empty()) continue;
+        if (line.front() == '[' && line.back() == ']') {
+            sections.emplace_back(trim(line.substr(1, line.size() - 2)), Settings());
+            continue;
+        }
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = path + ":" + std::to_string(lineNumber) + ": expected key = value";
+            return false;
+        }
+        Settings& target = sections.empty() ? global : sections.back().second;
+        target.emplace_back(trim(line.substr(0, equals)), trim(line.substr(equals + 1)));
+    }
+    if (sections.empty()) sections.emplace_back("default", Settings()); // Only global settings, one run
+
+    for (auto& [name, settings] : sections) {
+        Settings merged = global;
+        merged.insert(merged.end(), settings.begin(), settings.end());
+        merged.insert(merged.end(), overrides.begin(), overrides.end());
+        if (!expandScenarios(name, merged, scenarios, error)) return false;
+    }
+    return true;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--scenario file.ini] [--output results] [--key value]...\n"
+              << "\t--input file\t\tKey-value file to read (Source/Input/Clustered.txt)\n"
+              << "\t--table name\t\tlinear, flat, swiss, chain, bucket or all (all)\n"
+              << "\t--hash name\t\tfibonacci, modulo, multiply-shift, murmur or adaptive (fibonacci)\n"
+              << "\t--test name\t\tperformance, debug, misses, churn, latency, parallel, concurrency, snapshot, benchmark or workload (performance)\n"
+              << "\t--size n\t\tInitial table size, a power of 2 of at least " << MIN_TABLE_SIZE << " (1024)\n"
+              << "\t--lines n\t\tItems to read from the input file (500000)\n"
+              << "\t--operations n\t\tItems to insert, search and remove (lines / 10)\n"
+              << "\t--seed n\t\tSeed for random number generation (3)\n"
+              << "\t--incremental\t\tIncremental resize for linear and chain tables\n"
+              << "\t--tombstones\t\tTombstone deletes for the linear table\n"
+              << "\t--probing name\t\tlinear or robin-hood for the linear table (linear)\n"
+              << "\t--values name\t\tstring, or inline to keep short values in the slot (string)\n"
+              << "\t--rounds n\t\tChurn rounds (10)\n"
+              << "\t--snapshot file\t\tSnapshot test file (Source/Table.snapshot)\n"
+              << "\t--warmups n --trials n\tBenchmark runs (1 and 5)\n"
+              << "\t--counters\t\tBenchmark cycles and cache misses with perf_event_open\n"
+              << "\t--max-load x\t\tGrow once the load factor exceeds x (linear/flat 0.7, swiss 0.875, chain 2, bucket 4), open addressing caps it at 0.95\n"
+              << "\t--min-load x\t\tShrink to half once removes take the load factor under x, at most max / 4, 0 never shrinks (max / 8)\n"
+              << "\t--mix r/i/d\t\tWorkload read/insert/remove percentages (90/5/5)\n"
+              << "\t--distribution name\tWorkload key popularity: uniform, zipf or hotspot (uniform)\n"
+              << "\t--skew x\t\tZipf exponent (0.99)\n"
+              << "\t--hotspot k/a\t\tk% of the keys take a% of the accesses (10/90)\n"
+              << "\t--hits n\t\tPercent of workload reads for keys in the table (90)\n"
+              << "\t--record file\t\tSave the workload as a trace file\n"
+              << "\t--replay file\t\tRun a trace file instead of generating a workload\n"
+              << "\t--output base\t\tWrite benchmark rows to base.csv and base.json\n"
+              << "Values may be comma-separated lists, one run per combination, e.g. --hash fibonacci,modulo --lines 30000,500000\n";
+}
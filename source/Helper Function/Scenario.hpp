@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <utility>
+#include <optional>
+
+/*      -- Scenarios --
+One run of the driver: which tables, hash and test, on which input file and sizes.
+Settings come from command-line flags (--key value or --key=value) and/or an INI scenario file:
+    ; Settings before the first section apply to every run
+    input = Source/Input/Random.txt
+    [fibonacci-sweep]
+    hash = fibonacci
+    lines = 30000, 50000, 100000, 500000
+Each [section] is a run. A comma-separated value expands into one run per item (cross product over all lists).
+Command-line flags override the file.
+*/
+
+constexpr unsigned int MIN_TABLE_SIZE = 16; // Smallest --size: a Swiss group, and a 1 slot table would hash with a 32-bit shift
+
+struct Scenario {
+    std::string name = "default";
+    std::string input = "Source/Input/Clustered.txt"; // Key-value file to read
+    std::string table = "all"; // linear, flat, swiss, chain, bucket or all
+    std::string hash = "fibonacci"; // fibonacci, modulo, multiply-shift, murmur, adaptive
+    std::string test = "performance"; // performance, debug, misses, churn, latency, parallel, concurrency, snapshot, benchmark, workload
+    unsigned int initialSize = 1024; // Initial table size MUST be 2^n, at least MIN_TABLE_SIZE
+    unsigned int lines = 500000; // The number of items to read from the input file
+    unsigned int operations = 0; // Items to insert, remove, and search, 0 means lines / 10
+    unsigned int seed = 3; // Seed for random number generation
+    bool incremental = false; // Linear/Chain: incremental resize
+    bool tombstones = false; // Linear: tombstone deletes instead of backward shift
+    std::string probing = "linear"; // Linear: linear or robin-hood
+    std::string values = "string"; // Value type: string (std::string) or inline (InlineString)
+    unsigned int rounds = 10; // churn: rounds of removes and inserts
+    std::string snapshot = "Source/Table.snapshot"; // snapshot: file the table is saved to and loaded from
+    unsigned int warmups = 1, trials = 5; // benchmark: untimed and timed runs
+    bool counters = false; // benchmark: hardware counters
+    std::optional<double> maxLoad, minLoad; // Grow/shrink load factor limits, unset keeps the table's default max and max / 8
+    unsigned int readPercent = 90, insertPercent = 5, removePercent = 5; // workload: operation mix, given as "90/5/5"
+    std::string distribution = "uniform"; // workload: uniform, zipf or hotspot key popularity
+    double skew = 0.99; // workload: zipf exponent
+    unsigned int hotKeyPercent = 10, hotAccessPercent = 90; // workload: hotspot, given as "10/90"
+    unsigned int hitPercent = 90; // workload: percent of reads for keys in the table
+    std::string record, replay; // workload: trace file to write, trace file to run instead of generating one
+
+    unsigned int operationCount() const { return operations ? operations : lines / 10; }
+    std::string pattern() const; // File name of input without directory and extension, e.g. "Random"
+};
+
+using Settings = std::vector<std::pair<std::string, std::string>>; // key = value, in the order they were given
+
+bool setOption(Scenario& scenario, const std::string& key, const std::string& value, std::string& error); // false and error set if invalid
+bool parseArguments(int argc, char** argv, Settings& settings, std::string& scenarioFile, std::string& output, std::string& error);
+bool expandScenarios(const std::string& name, const Settings& settings, std::vector<Scenario>& scenarios, std::string& error);
+bool loadScenarios(const std::string& path, const Settings& overrides, std::vector<Scenario>& scenarios, std::string& error);
+void printUsage(const char* program);
@@ -0,0 +1,129 @@
+#include "Workload.hpp"
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include "../Hash Table/MappedFile.hpp"
+
+ZipfDistribution::ZipfDistribution(unsigned int n, double skew) : cdf(std::max(n, 1u)) {
+    double total = 0;
+    for (unsigned int rank = 0; rank < cdf.size(); rank++) {
+        total += 1 / std::pow(rank + 1.0, skew);
+        cdf[rank] = total;
+    }
+    for (double& weight : cdf) weight /= total;
+}
+
+unsigned int ZipfDistribution::operator()(Xoshiro256& random) const {
+    auto rank = std::upper_bound(cdf.begin(), cdf.end(), random.unit());
+    return std::min<size_t>(rank - cdf.begin(), cdf.size() - 1); // Rounding may leave the last weight a hair under 1
+}
+
+std::vector<unsigned int> readKeys(const std::string& path, unsigned int n) {
+    std::vector<unsigned int> keys;
+    MappedFile file(path);
+    if (!file.isOpen()) return keys;
+    keys.reserve(countLines(file.begin(), file.end(), n));
+    const char* cursor = file.begin();
+    unsigned int key;
+    std::string_view value;
+    while (n-- > 0 && parseRecord(cursor, file.end(), key, value)) keys.push_back(key);
+    return keys;
+}
+
+std::vector<WorkloadOperation> generateWorkload(std::vector<unsigned int> tableKeys, const WorkloadOptions& options) {
+    Xoshiro256 random(options.seed);
+    std::sort(tableKeys.begin(), tableKeys.end()); // Input files repeat some keys, each live key is held once
+    tableKeys.erase(std::unique(tableKeys.begin(), tableKeys.end()), tableKeys.end());
+    std::shuffle(tableKeys.begin(), tableKeys.end(), random); // Popularity ranks in random key order
+    std::vector<unsigned int>& live = tableKeys; // Removes swap the last key into the hole, inserts append
+    std::unordered_set<unsigned int> inserted; // New keys handed out so far
+
+    std::unique_ptr<ZipfDistribution> zipf;
+    if (options.distribution == KeyDistribution::Zipf) zipf.reset(new ZipfDistribution(live.size(), options.skew));
+    auto pick = [&]() -> unsigned int { // Index into live, which must not be empty
+        unsigned int size = live.size();
+        if (options.distribution == KeyDistribution::Zipf) return (*zipf)(random) % size; // Ranks past the end wrap once removes shrink live
+        if (options.distribution == KeyDistribution::Hotspot) {
+            unsigned int hot = std::clamp(unsigned(uint64_t(size) * options.hotKeyPercent / 100), 1u, size);
+            if (hot == size || random.below(100) < options.hotAccessPercent) return random.below(hot);
+            return hot + random.below(size - hot);
+        }
+        return random.below(size);
+    };
+    auto missingKey = [&]() { return 1000000001u + 2 * random.below(1500000000); }; // Odd, never inserted
+    auto newKey = [&]() {
+        unsigned int key;
+        do key = 1000000000u + 2 * random.below(1500000000); // Even
+        while (!inserted.insert(key).second);
+        return key;
+    };
+
+    std::vector<WorkloadOperation> operations;
+    operations.reserve(options.operations);
+    for (unsigned int i = 0; i < options.operations; i++) {
+        unsigned int roll = random.below(100);
+        if (roll < options.readPercent) {
+            bool hit = !live.empty() && random.below(100) < options.hitPercent;
+            operations.push_back({WorkloadOperation::Search, hit ? live[pick()] : missingKey()});
+        }
+        else if (roll < options.readPercent + options.insertPercent) {
+            unsigned int key = newKey();
+            live.push_back(key);
+            operations.push_back({WorkloadOperation::Insert, key});
+        }
+        else if (live.empty()) operations.push_back({WorkloadOperation::Remove, missingKey()}); // Nothing left to remove
+        else {
+            unsigned int index = pick();
+            operations.push_back({WorkloadOperation::Remove, live[index]});
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+    return operations;
+}
+
+std::string describeWorkload(const WorkloadOptions& options) {
+    std::ostringstream text;
+    text << options.readPercent << "/" << options.insertPercent << "/" << options.removePercent << " read/insert/remove, ";
+    if (options.distribution == KeyDistribution::Zipf) text << "zipf keys (skew " << options.skew << ")";
+    else if (options.distribution == KeyDistribution::Hotspot) text << "hotspot keys (" << options.hotKeyPercent << "% of keys take " << options.hotAccessPercent << "% of accesses)";
+    else text << "uniform keys";
+    text << ", " << options.hitPercent << "% hits";
+    return text.str();
+}
+
+bool writeTrace(const std::string& path, const std::vector<WorkloadOperation>& operations, const std::string& comment) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) return false;
+    if (!comment.empty()) file << "# " << comment << "\n";
+    static const char codes[] = {'s', 'i', 'r'}; // Indexed by WorkloadOperation::Type
+    for (const WorkloadOperation& operation : operations) file << codes[operation.type] << ' ' << operation.key << '\n';
+    return bool(file);
+}
+
+bool readTrace(const std::string& path, std::vector<WorkloadOperation>& operations) {
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+    operations.clear();
+    operations.reserve(countLines(file.begin(), file.end(), UINT32_MAX));
+    const char* cursor = file.begin();
+    while (cursor < file.end()) {
+        const char* line = cursor;
+        const char* lineEnd = std::find(line, file.end(), '\n');
+        cursor = lineEnd + (lineEnd < file.end());
+        while (line < lineEnd && (*line == ' ' || *line == '\t' || *line == '\r')) line++;
+        if (line == lineEnd || *line == '#') continue; // Blank line or comment
+
+        WorkloadOperation operation;
+        if (*line == 's') operation.type = WorkloadOperation::Search;
+        else if (*line == 'i') operation.type = WorkloadOperation::Insert;
+        else if (*line == 'r') operation.type = WorkloadOperation::Remove;
+        else return false;
+        line++;
+        while (line < lineEnd && (*line == ' ' || *line == '\t')) line++;
+        auto [end, error] = std::from_chars(line, lineEnd, operation.key);
+        if (error != std::errc() || (end < lineEnd && *end != '\r' && *end != ' ' && *end != '\t')) return false;
+        operations.push_back(operation);
+    }
+    return true;
+}
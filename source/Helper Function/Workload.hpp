@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "HelperFunction.hpp"
+
+/*      -- Workloads --
+A stream of searches, inserts and removes shaped like production traffic, over the keys loaded from the input file:
+    mix: read/insert/remove percentages, e.g. 90/5/5
+    keys: uniform, zipf (the key of popularity rank r is picked with probability ~ 1 / (r + 1)^skew)
+          or hotspot (hot% of the keys take access% of the picks, the rest are uniform)
+    hits: percent of reads for live keys, the rest ask for keys that were never inserted
+The generator tracks the live keys, so the hit ratio holds while inserts and removes change the table.
+Ranks are over the live keys in shuffled order, hot keys are spread over the key space instead of being the first
+lines of the file. New keys are even and missing ones odd, both above the 9-digit input keys, so they never collide.
+A workload can be saved as a trace and replayed, one operation per line ('#' lines are comments):
+    s 244272508     search
+    i 1000000042    insert
+    r 946885252     remove
+*/
+
+enum class KeyDistribution { Uniform, Zipf, Hotspot };
+
+struct WorkloadOptions {
+    unsigned int operations = 50000;
+    unsigned int readPercent = 90, insertPercent = 5, removePercent = 5; // Operation mix, adds up to 100
+    unsigned int hitPercent = 90; // Reads of live keys, the rest miss
+    KeyDistribution distribution = KeyDistribution::Uniform;
+    double skew = 0.99; // Zipf exponent, YCSB's default
+    unsigned int hotKeyPercent = 10, hotAccessPercent = 90; // Hotspot: hotKeyPercent of the keys take hotAccessPercent of the picks
+    uint64_t seed = 3;
+};
+
+struct WorkloadOperation {
+    enum Type : uint8_t { Search, Insert, Remove };
+    Type type;
+    unsigned int key;
+};
+
+// Zipf ranks in [0, n) for any skew > 0, a binary search of the cumulative weights per draw
+struct ZipfDistribution {
+    std::vector<double> cdf; // cdf[r]: probability of a rank <= r
+
+    ZipfDistribution(unsigned int n, double skew);
+    unsigned int operator()(Xoshiro256& random) const;
+};
+
+std::vector<unsigned int> readKeys(const std::string& path, unsigned int n); // Keys of the first n lines of a "key value" file
+std::vector<WorkloadOperation> generateWorkload(std::vector<unsigned int> tableKeys, const WorkloadOptions& options);
+std::string describeWorkload(const WorkloadOptions& options); // e.g. "90/5/5 read/insert/remove, zipf keys (skew 0.99), 90% hits"
+bool writeTrace(const std::string& path, const std::vector<WorkloadOperation>& operations, const std::string& comment = "");
+bool readTrace(const std::string& path, std::vector<WorkloadOperation>& operations); // false if missing or malformed
+
+// Load n items, then run a generated or replayed workload against them and report throughput and read hits
+template <typename HashTableType>
+void testWorkload(const std::string& inputFile, HashTableType& hashTable, unsigned int n, const WorkloadOptions& options,
+                  const std::string& recordFile, const std::string& replayFile) {
+    std::vector<WorkloadOperation> operations;
+    std::pair<double, double> timeMemory;
+
+    std::cout << "Testing workload with " << n << " items from " << inputFile << "\n";
+    if (!replayFile.empty() && !readTrace(replayFile, operations)) {
+        std::cout << "Could not read trace " << replayFile << "\n";
+        return;
+    }
+
+    std::cout << "\n\tInputing " << n << " items...\n";
+    timeMemory = measureExecutionTime([&]() {
+        hashTable.input(inputFile, n);
+    });
+    hashTable.outputStats();
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+
+    if (replayFile.empty()) {
+        operations = generateWorkload(readKeys(inputFile, n), options);
+        std::cout << "\n\tRunning " << operations.size() << " operations: " << describeWorkload(options) << "...\n";
+    }
+    else std::cout << "\n\tReplaying " << operations.size() << " operations from " << replayFile << "...\n";
+    if (!recordFile.empty() && !writeTrace(recordFile, operations, replayFile.empty() ? describeWorkload(options) : "Replay of " + replayFile)) {
+        std::cout << "Could not write trace " << recordFile << "\n";
+    }
+
+    typename HashTableType::ValueType value("Password123@");
+    unsigned int reads = 0, hits = 0;
+    timeMemory = measureExecutionTime([&]() {
+        for (const WorkloadOperation& operation : operations) {
+            switch (operation.type) {
+            case WorkloadOperation::Search:
+                reads++;
+                if (!hashTable.search(operation.key).empty()) hits++;
+                break;
+            case WorkloadOperation::Insert: hashTable.insert(operation.key, value); break;
+            case WorkloadOperation::Remove: hashTable.remove(operation.key); break;
+            }
+        }
+    });
+    hashTable.outputStats();
+    std::cout << "-Read Hits: " << hits << "/" << reads << std::endl;
+    std::cout << "Throughput: " << operations.size() / timeMemory.first / 1000 << " million operations/s\n";
+    printPerformance(timeMemory.first, timeMemory.second);
+    hashTable.resetStats();
+}
@@ -1,39 +1,174 @@
-#include "Hash Table/HashTable.hpp"
-#include "Helper Function/HelperFunction.hpp"
-
-/*      -- Test Different Key Patterns --
-- Input/*.txt contains pairs of unsigned integer KEYS(IDs) and string VALUES(Passwords) for each lines.
-    "Source/Input/Random.txt": Random keys pattern.
-    "Source/Input/Sequential.txt": Sequential keys pattern.
-    "Source/Input/Clustered.txt": Clustered keys pattern.
-*/
-
-const std::string INPUT_FILE = "Source/Input/Clustered.txt";
-const unsigned int INITIAL_SIZE = 1024; // Initial table size MUST be 2^n
-const unsigned int LINE_TO_READ = 500000; // The number of items to read from the input file
-const bool USE_FIBONACCI = true; // Use Fibonacci hashing if true, modulo hashing if false
-const unsigned int OPERATION_SIZE = LINE_TO_READ / 10; // Number of Items to insert, remove, and search in the hash table
-const unsigned int SEED = 3; // Seed for random number generation
-
-int main() {
-    srand(SEED);
-    LinearHashTable linearHashTable(INITIAL_SIZE, USE_FIBONACCI);
-    ChainHashTable chainHashTable(INITIAL_SIZE, USE_FIBONACCI);
-
-// Linear Hash Table Test
-    // debugHashTable(INPUT_FILE, linearHashTable, LINE_TO_READ, OPERATION_SIZE);
-    testPerformance(INPUT_FILE, linearHashTable, LINE_TO_READ, OPERATION_SIZE);
-
-// Chain Hash Table Test
-    // debugHashTable(INPUT_FILE, chainHashTable, LINE_TO_READ, OPERATION_SIZE);
-    testPerformance(INPUT_FILE, chainHashTable, LINE_TO_READ, OPERATION_SIZE);
-
-// Test generating different key patterns
-    // std::ofstream outputFile("Source/output.txt");
-    // std::vector<unsigned int> randomKeys = generateRandomKeys(OPERATION_SIZE);
-    // std::vector<unsigned int> sequentialKeys = generateSequentialKeys(OPERATION_SIZE);
-    // std::vector<unsigned int> clusteredKeys = generateClusteredKeys(OPERATION_SIZE);
-    // if (outputFile.is_open()) for (const int key : clusteredKeys) outputFile << key << std::endl;
-
-    return 0;
-}
\ No newline at end of file
+#include "Hash Table/HashTable.hpp"
+#include "Hash Table/FlatHashTable.hpp"
+#include "Hash Table/SwissHashTable.hpp"
+#include "Hash Table/BucketChainHashTable.hpp"
+#include "Hash Table/ConcurrentHashTable.hpp"
+#include "Helper Function/HelperFunction.hpp"
+#include "Helper Function/Benchmark.hpp"
+#include "Helper Function/Scenario.hpp"
+#include "Helper Function/Workload.hpp"
+
+/*      -- Test Different Key Patterns --
+- Input/<Pattern>.txt contains pairs of unsigned integer KEYS(IDs) and string VALUES(Passwords) for each lines.
+    "Source/Input/Random.txt": Random keys pattern.
+    "Source/Input/Sequential.txt": Sequential keys pattern.
+    "Source/Input/Clustered.txt": Clustered keys pattern.
+Pick the file, tables, hash and test with flags or a scenario file (see Helper Function/Scenario.hpp and Scenarios/Sweep.ini).
+Without arguments every table runs testPerformance() on Clustered.txt with Fibonacci hashing.
+*/
+
+// Builds a table with the scenario's options, tables without them only take the initial size
+template <typename HashTableType>
+struct TableFactory {
+    static constexpr bool threaded = false; // Has parallelInput() and can be sharded by ConcurrentHashTable
+    static constexpr bool snapshots = true; // Has saveSnapshot() and loadSnapshot()
+    static HashTableType make(const Scenario& scenario) { return HashTableType(scenario.initialSize); }
+    static std::string variant(const Scenario&) { return ""; } // Options make() applied, appended to benchmark row names
+};
+
+template <typename Hash, typename Value>
+struct TableFactory<LinearHashTable<Hash, unsigned int, Value>> {
+    static constexpr bool threaded = true;
+    static constexpr bool snapshots = true;
+    using Table = LinearHashTable<Hash, unsigned int, Value>;
+    static Table make(const Scenario& scenario) {
+        auto deleteMode = scenario.tombstones ? Table::DeleteMode::Tombstone : Table::DeleteMode::BackwardShift;
+        auto probeMode = scenario.probing == "robin-hood" ? Table::ProbeMode::RobinHood : Table::ProbeMode::Linear;
+        return Table(scenario.initialSize, deleteMode, scenario.incremental, probeMode);
+    }
+    static std::string variant(const Scenario& scenario) {
+        std::string name;
+        if (scenario.probing == "robin-hood") name += "/robin-hood"; // Robin Hood tables always shift back, tombstones are ignored
+        else if (scenario.tombstones) name += "/tombstones";
+        if (scenario.incremental) name += "/incremental";
+        return name;
+    }
+};
+
+template <typename Hash, typename Value>
+struct TableFactory<ChainHashTable<Hash, unsigned int, Value>> {
+    static constexpr bool threaded = true;
+    static constexpr bool snapshots = false; // Nodes live in slabs, there is no slot array to save
+    static ChainHashTable<Hash, unsigned int, Value> make(const Scenario& scenario) { return ChainHashTable<Hash, unsigned int, Value>(scenario.initialSize, scenario.incremental); }
+    static std::string variant(const Scenario& scenario) { return scenario.incremental ? "/incremental" : ""; }
+};
+
+template <typename Hash, typename Value>
+struct TableFactory<BucketChainHashTable<Hash, unsigned int, Value>> {
+    static constexpr bool threaded = false;
+    static constexpr bool snapshots = false; // Overflow blocks live in slabs, like the Chain table's nodes
+    static BucketChainHashTable<Hash, unsigned int, Value> make(const Scenario& scenario) { return BucketChainHashTable<Hash, unsigned int, Value>(scenario.initialSize); }
+    static std::string variant(const Scenario&) { return ""; }
+};
+
+WorkloadOptions workloadOptions(const Scenario& scenario) {
+    WorkloadOptions options;
+    options.operations = scenario.operationCount();
+    options.readPercent = scenario.readPercent;
+    options.insertPercent = scenario.insertPercent;
+    options.removePercent = scenario.removePercent;
+    options.hitPercent = scenario.hitPercent;
+    if (scenario.distribution == "zipf") options.distribution = KeyDistribution::Zipf;
+    else if (scenario.distribution == "hotspot") options.distribution = KeyDistribution::Hotspot;
+    options.skew = scenario.skew;
+    options.hotKeyPercent = scenario.hotKeyPercent;
+    options.hotAccessPercent = scenario.hotAccessPercent;
+    options.seed = scenario.seed;
+    return options;
+}
+
+// Every table is fresh and seeded the same way, runs don't see each other's state
+template <typename HashTableType>
+void runTable(const Scenario& scenario, const std::string& tableName, std::vector<BenchmarkResult>& results) {
+    testRandom() = Xoshiro256(scenario.seed);
+    const std::string& test = scenario.test;
+    if (test == "benchmark") {
+        BenchmarkOptions options = {scenario.warmups, scenario.trials, scenario.counters, scenario.maxLoad, scenario.minLoad};
+        auto makeTable = [&]() { return TableFactory<HashTableType>::make(scenario); }; // Same options as the other tests
+        benchmarkTable<HashTableType>(results, options, tableName + TableFactory<HashTableType>::variant(scenario), scenario.pattern(), scenario.input,
+                                      makeTable, scenario.lines, scenario.operationCount());
+        return;
+    }
+    if (test == "parallel" || test == "concurrency") {
+        if constexpr (TableFactory<HashTableType>::threaded) {
+            if (test == "parallel") testParallelBuild<HashTableType>(scenario.input, scenario.initialSize, scenario.lines);
+            else testConcurrency<ConcurrentHashTable<HashTableType>>(scenario.input, scenario.initialSize, scenario.lines, scenario.operationCount());
+        }
+        else std::cout << "Skipping " << tableName << " Hash Table, no " << test << " test for it\n";
+        return;
+    }
+
+    if (test == "snapshot" && !TableFactory<HashTableType>::snapshots) {
+        std::cout << "Skipping " << tableName << " Hash Table, no " << test << " test for it\n";
+        return;
+    }
+
+    HashTableType hashTable = TableFactory<HashTableType>::make(scenario);
+    setLoadFactor(hashTable, scenario.maxLoad, scenario.minLoad);
+    if (test == "performance") testPerformance(scenario.input, hashTable, scenario.lines, scenario.operationCount());
+    else if (test == "debug") debugHashTable(scenario.input, hashTable, scenario.lines, scenario.operationCount());
+    else if (test == "misses") testMisses(scenario.input, hashTable, scenario.lines, scenario.operationCount());
+    else if (test == "churn") testChurn(hashTable, scenario.lines, scenario.operationCount(), scenario.rounds);
+    else if (test == "latency") testLatency(scenario.input, hashTable, scenario.lines, scenario.operationCount());
+    else if (test == "workload") testWorkload(scenario.input, hashTable, scenario.lines, workloadOptions(scenario), scenario.record, scenario.replay);
+    else if (test == "snapshot") {
+        if constexpr (TableFactory<HashTableType>::snapshots) testSnapshot(scenario.input, hashTable, scenario.lines, scenario.snapshot);
+    }
+}
+
+template <typename Hash, typename Value>
+void runTables(const Scenario& scenario, std::vector<BenchmarkResult>& results) {
+    bool all = scenario.table == "all";
+    std::string suffix = scenario.values == "inline" ? "/inline" : ""; // Keeps benchmark rows of the two value types apart
+    if (all || scenario.table == "linear") runTable<LinearHashTable<Hash, unsigned int, Value>>(scenario, "Linear" + suffix, results);
+    if (all || scenario.table == "flat") runTable<FlatLinearHashTable<Hash, unsigned int, Value>>(scenario, "FlatLinear" + suffix, results);
+    if (all || scenario.table == "swiss") runTable<SwissHashTable<Hash, unsigned int, Value>>(scenario, "Swiss" + suffix, results);
+    if (all || scenario.table == "chain") runTable<ChainHashTable<Hash, unsigned int, Value>>(scenario, "Chain" + suffix, results);
+    if (all || scenario.table == "bucket") runTable<BucketChainHashTable<Hash, unsigned int, Value>>(scenario, "BucketChain" + suffix, results);
+}
+
+template <typename Hash>
+void runScenario(const Scenario& scenario, std::vector<BenchmarkResult>& results) {
+    if (scenario.values == "inline") runTables<Hash, InlineString>(scenario, results);
+    else runTables<Hash, std::string>(scenario, results);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    Settings settings;
+    std::vector<Scenario> scenarios;
+    std::string scenarioFile, output, error;
+    bool parsed = parseArguments(argc, argv, settings, scenarioFile, output, error)
+               && (scenarioFile.empty() ? expandScenarios("default", settings, scenarios, error) : loadScenarios(scenarioFile, settings, scenarios, error));
+    if (!parsed) {
+        std::cerr << "Error: " << error << "\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (const Scenario& scenario : scenarios) {
+        std::cout << "\n\t\t===" << scenario.name << ": " << scenario.test << ", " << scenario.table << " table(s), " << scenario.hash
+                  << " hash, " << scenario.lines << " items from " << scenario.input << "===\n";
+        if (scenario.hash == "fibonacci") runScenario<FibonacciHash>(scenario, results);
+        else if (scenario.hash == "modulo") runScenario<ModuloHash>(scenario, results);
+        else if (scenario.hash == "multiply-shift") runScenario<MultiplyShiftHash>(scenario, results);
+        else if (scenario.hash == "adaptive") runScenario<AdaptiveHash>(scenario, results);
+        else runScenario<MurmurHash>(scenario, results);
+    }
+
+    if (!results.empty()) {
+        printBenchmark(results);
+        if (!output.empty() && (!writeCSV(output + ".csv", results) || !writeJSON(output + ".json", results))) {
+            std::cerr << "Could not write " << output << ".csv/.json\n";
+            return 1;
+        }
+    }
+    return 0;
+}